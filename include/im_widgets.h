@@ -2,6 +2,8 @@
 
 #include "imgui.h"
 
+#include <atomic>
+
 struct ImWidgetsStyle {
     /* Toggle switch styling  */
     float   ImToggleSwitchRadius;
@@ -48,6 +50,98 @@ struct ImWidgetsStyle {
     ImVec4  ImCalendarHoveredCellColor;
     ImVec4  ImCalendarActivePressFeedBack;
     ImVec4  ImCalendarBgColor;
+
+    /* Rich Text */
+    float   ImRichTextItalicShear;
+    ImVec4  ImRichTextLinkColor;
+    ImVec4  ImRichTextLinkHoveredColor;
+
+    /* Log Viewer */
+    ImVec2  ImLogViewerSize;
+    ImVec4  ImLogViewerErrorColor;
+    ImVec4  ImLogViewerWarningColor;
+    ImVec4  ImLogViewerInfoColor;
+    ImVec4  ImLogViewerDebugColor;
+
+    /* Data Grid */
+    ImVec2  ImDataGridSize;
+    float   ImDataGridFilterTimeBudget;
+
+    /* Tree View */
+    ImVec2  ImTreeViewSize;
+    ImVec4  ImTreeViewArrowColor;
+
+    /* Line Plot */
+    ImVec2  ImLinePlotSize;
+    float   ImLinePlotThickness;
+    ImVec4  ImLinePlotLineColor;
+    ImVec4  ImLinePlotBgColor;
+
+    /* Histogram */
+    ImVec2  ImHistogramSize;
+    ImVec4  ImHistogramBarColor;
+    ImVec4  ImHistogramBarHoveredColor;
+    ImVec4  ImHistogramBgColor;
+
+    /* Heatmap */
+    ImVec2  ImHeatmapSize;
+    ImVec4  ImHeatmapLowColor;
+    ImVec4  ImHeatmapMidColor;
+    ImVec4  ImHeatmapHighColor;
+
+    /* Sparkline */
+    ImVec2  ImSparklineSize;
+    ImVec4  ImSparklineColor;
+
+    /* Scatter Plot */
+    ImVec2  ImScatterPlotSize;
+    float   ImScatterPlotMarkerSize;
+    int     ImScatterPlotMaxMarkers;
+    ImVec4  ImScatterPlotColor;
+    ImVec4  ImScatterPlotBgColor;
+
+    /* Flame Graph */
+    ImVec2  ImFlameGraphSize;
+    float   ImFlameGraphRowHeight;
+    ImVec4  ImFlameGraphColdColor;
+    ImVec4  ImFlameGraphHotColor;
+    ImVec4  ImFlameGraphMergedColor;
+    ImVec4  ImFlameGraphTextColor;
+    ImVec4  ImFlameGraphBgColor;
+
+    /* Timeline */
+    ImVec2  ImTimelineSize;
+    float   ImTimelineLaneHeight;
+    ImVec4  ImTimelineSpanColor;
+    ImVec4  ImTimelineDensityColor;
+    ImVec4  ImTimelineTextColor;
+    ImVec4  ImTimelineAxisColor;
+    ImVec4  ImTimelineBgColor;
+
+    /* Hex Viewer */
+    ImVec2  ImHexViewerSize;
+    ImVec4  ImHexViewerAddressColor;
+    ImVec4  ImHexViewerAsciiColor;
+    ImVec4  ImHexViewerSelectionColor;
+    ImVec4  ImHexViewerMatchColor;
+    ImVec4  ImHexViewerErrorColor;
+
+    /* Fuzzy Search */
+    int     ImFuzzySearchMaxResults;
+    float   ImFuzzySearchListHeight;
+    float   ImCommandPaletteWidth;
+    ImVec4  ImFuzzySearchMatchColor;
+
+    /* Toggle Grid */
+    ImVec2  ImToggleGridCellSize;
+    float   ImToggleGridSpacing;
+
+    /* Progress List */
+    float   ImProgressListRowHeight;
+    float   ImProgressListLabelWidth;
+    ImVec4  ImProgressListQueuedColor;
+    ImVec4  ImProgressListDoneColor;
+    ImVec4  ImProgressListFailedColor;
 };
 
 enum ImToggleFlags_ {
@@ -62,6 +156,7 @@ enum ImRadioButtonGroupFlags_ {
     ImRadioButtonGroupFlags_NoLabel     = 1 << 0,
     ImRadioButtonGroupFlags_Vertical    = 1 << 1,
     ImRadioButtonGroupFlags_Disabled    = 1 << 2,
+    ImRadioButtonGroupFlags_Virtualized = 1 << 3,   // Only submit the items in view, for groups with hundreds of items
 };
 
 enum ImProgressBarFlags_ {
@@ -83,11 +178,443 @@ enum ImCalendarFlags_ {
     ImCalendarFlags_SelectableDate       = 1 << 0,
 };
 
+enum ImRichTextFlags_ {
+    ImRichTextFlags_None                 = 0,
+    ImRichTextFlags_NoWrap               = 1 << 0,
+};
+
+enum ImLogViewerFlags_ {
+    ImLogViewerFlags_None                = 0,
+    ImLogViewerFlags_NoFollow            = 1 << 0,
+    ImLogViewerFlags_NoSeverityColors    = 1 << 1,
+    ImLogViewerFlags_LineNumbers         = 1 << 2,
+    ImLogViewerFlags_Search              = 1 << 3,
+};
+
+enum ImDataGridFlags_ {
+    ImDataGridFlags_None                 = 0,
+    ImDataGridFlags_NoFilter             = 1 << 0,
+    ImDataGridFlags_NoSort               = 1 << 1,
+};
+
+enum ImTreeViewFlags_ {
+    ImTreeViewFlags_None                 = 0,
+    ImTreeViewFlags_ExpandOnClick        = 1 << 0,
+};
+
+enum ImLinePlotFlags_ {
+    ImLinePlotFlags_None                 = 0,
+    ImLinePlotFlags_NoInteraction        = 1 << 0,
+    ImLinePlotFlags_NoTooltip            = 1 << 1,
+    ImLinePlotFlags_NoLabels             = 1 << 2,
+};
+
+enum ImHistogramFlags_ {
+    ImHistogramFlags_None                = 0,
+    ImHistogramFlags_NoTooltip           = 1 << 0,
+    ImHistogramFlags_NoLabels            = 1 << 1,
+};
+
+enum ImHeatmapFlags_ {
+    ImHeatmapFlags_None                  = 0,
+    ImHeatmapFlags_NoTooltip             = 1 << 0,
+};
+
+enum ImSparklineFlags_ {
+    ImSparklineFlags_None                = 0,
+    ImSparklineFlags_NoTooltip           = 1 << 0,
+};
+
+enum ImScatterPlotFlags_ {
+    ImScatterPlotFlags_None              = 0,
+    ImScatterPlotFlags_NoInteraction     = 1 << 0,
+    ImScatterPlotFlags_NoTooltip         = 1 << 1,
+    ImScatterPlotFlags_BinnedMarkers     = 1 << 2,
+};
+
+enum ImFlameGraphFlags_ {
+    ImFlameGraphFlags_None               = 0,
+    ImFlameGraphFlags_NoInteraction      = 1 << 0,
+    ImFlameGraphFlags_NoTooltip          = 1 << 1,
+    ImFlameGraphFlags_Inverted           = 1 << 2,   // Roots at the bottom (flame graph) instead of the top (icicle)
+};
+
+enum ImTimelineFlags_ {
+    ImTimelineFlags_None                 = 0,
+    ImTimelineFlags_NoInteraction        = 1 << 0,
+    ImTimelineFlags_NoTooltip            = 1 << 1,
+    ImTimelineFlags_DateAxis             = 1 << 2,   // Times are seconds since 1970-01-01 UTC, see DateToTime()
+};
+
+enum ImHexViewerFlags_ {
+    ImHexViewerFlags_None                = 0,
+    ImHexViewerFlags_NoAscii             = 1 << 0,
+    ImHexViewerFlags_NoInspector         = 1 << 1,   // No data inspector tooltip over bytes
+    ImHexViewerFlags_Search              = 1 << 2,
+};
+
+enum ImFuzzySearchFlags_ {
+    ImFuzzySearchFlags_None              = 0,
+    ImFuzzySearchFlags_CaseSensitive     = 1 << 0,
+    ImFuzzySearchFlags_NoHighlight       = 1 << 1,   // Don't color the matched characters
+};
+
+enum ImToggleGridFlags_ {
+    ImToggleGridFlags_None               = 0,
+    ImToggleGridFlags_Disabled           = 1 << 0,
+    ImToggleGridFlags_NoAnimation        = 1 << 1,
+    ImToggleGridFlags_NoTooltip          = 1 << 2,
+};
+
+enum ImProgressListFlags_ {
+    ImProgressListFlags_None             = 0,
+    ImProgressListFlags_NoTotals         = 1 << 0,   // No summary line above the rows
+    ImProgressListFlags_NoLabels         = 1 << 1,   // No label column, bars take the whole width
+    ImProgressListFlags_NoTooltip        = 1 << 2,
+};
+
+enum ImProgressItemState_ {
+    ImProgressItemState_Queued,
+    ImProgressItemState_Running,
+    ImProgressItemState_Done,
+    ImProgressItemState_Failed,
+    ImProgressItemState_COUNT
+};
+
+/* Background task queues, visible-widget work always runs first */
+enum ImTaskPriority_ {
+    ImTaskPriority_Visible,         // Submitted by a widget drawn last frame
+    ImTaskPriority_Background,      // Its widget was not drawn last frame, dropped after 60 frames out of sight
+    ImTaskPriority_COUNT
+};
+
+/* ImWidgetsStyle colors, for ImWidgets::PushStyleColor() and ImWidgets::GetColorU32() */
+enum ImWidgetsCol_ {
+    ImWidgetsCol_ToggleSwitchOn,
+    ImWidgetsCol_ToggleSwitchOff,
+    ImWidgetsCol_ToggleSwitchKnob,
+    ImWidgetsCol_ToggleSwitchDisabled,
+
+    ImWidgetsCol_RadioButtonGroupActive,
+    ImWidgetsCol_RadioButtonGroupInactive,
+    ImWidgetsCol_RadioButtonGroupDisabled,
+    ImWidgetsCol_RadioButtonGroupActiveText,
+    ImWidgetsCol_RadioButtonGroupInactiveText,
+    ImWidgetsCol_RadioButtonGroupDisabledText,
+
+    ImWidgetsCol_ProgressBarBg,
+    ImWidgetsCol_ProgressBar,
+    ImWidgetsCol_ProgressBarText,
+
+    ImWidgetsCol_Spinner,
+
+    ImWidgetsCol_CalendarText,
+    ImWidgetsCol_CalendarBorderStrong,
+    ImWidgetsCol_CalendarBorderLight,
+    ImWidgetsCol_CalendarSelectedCell,
+    ImWidgetsCol_CalendarHoveredCell,
+    ImWidgetsCol_CalendarActivePressFeedBack,
+    ImWidgetsCol_CalendarBg,
+
+    ImWidgetsCol_RichTextLink,
+    ImWidgetsCol_RichTextLinkHovered,
+
+    ImWidgetsCol_LogViewerError,
+    ImWidgetsCol_LogViewerWarning,
+    ImWidgetsCol_LogViewerInfo,
+    ImWidgetsCol_LogViewerDebug,
+
+    ImWidgetsCol_TreeViewArrow,
+
+    ImWidgetsCol_LinePlotLine,
+    ImWidgetsCol_LinePlotBg,
+
+    ImWidgetsCol_HistogramBar,
+    ImWidgetsCol_HistogramBarHovered,
+    ImWidgetsCol_HistogramBg,
+
+    ImWidgetsCol_HeatmapLow,
+    ImWidgetsCol_HeatmapMid,
+    ImWidgetsCol_HeatmapHigh,
+
+    ImWidgetsCol_Sparkline,
+
+    ImWidgetsCol_ScatterPlot,
+    ImWidgetsCol_ScatterPlotBg,
+
+    ImWidgetsCol_FlameGraphCold,
+    ImWidgetsCol_FlameGraphHot,
+    ImWidgetsCol_FlameGraphMerged,
+    ImWidgetsCol_FlameGraphText,
+    ImWidgetsCol_FlameGraphBg,
+
+    ImWidgetsCol_TimelineSpan,
+    ImWidgetsCol_TimelineDensity,
+    ImWidgetsCol_TimelineText,
+    ImWidgetsCol_TimelineAxis,
+    ImWidgetsCol_TimelineBg,
+
+    ImWidgetsCol_HexViewerAddress,
+    ImWidgetsCol_HexViewerAscii,
+    ImWidgetsCol_HexViewerSelection,
+    ImWidgetsCol_HexViewerMatch,
+    ImWidgetsCol_HexViewerError,
+
+    ImWidgetsCol_FuzzySearchMatch,
+
+    ImWidgetsCol_ProgressListQueued,
+    ImWidgetsCol_ProgressListDone,
+    ImWidgetsCol_ProgressListFailed,
+    ImWidgetsCol_COUNT
+};
+
+/* ImWidgetsStyle float and ImVec2 fields, for ImWidgets::PushStyleVar() */
+enum ImWidgetsStyleVar_ {
+    ImWidgetsStyleVar_ToggleSwitchRadius,
+    ImWidgetsStyleVar_ToggleSwitchSize,
+
+    ImWidgetsStyleVar_RadioButtonGroupRadius,
+    ImWidgetsStyleVar_RadioButtonGroupSpacing,
+    ImWidgetsStyleVar_RadioButtonGroupSize,
+
+    ImWidgetsStyleVar_ProgressBarRadius,
+    ImWidgetsStyleVar_ProgressBarCircleRadius,
+    ImWidgetsStyleVar_ProgressBarCircleThickness,
+    ImWidgetsStyleVar_ProgressBarSize,
+
+    ImWidgetsStyleVar_SpinnerRadius,
+    ImWidgetsStyleVar_SpinnerThickness,
+    ImWidgetsStyleVar_SpinnerSpeed,
+
+    ImWidgetsStyleVar_CalendarInnerWidth,
+    ImWidgetsStyleVar_CalendarOuterSize,
+
+    ImWidgetsStyleVar_RichTextItalicShear,
+
+    ImWidgetsStyleVar_LogViewerSize,
+
+    ImWidgetsStyleVar_DataGridSize,
+    ImWidgetsStyleVar_DataGridFilterTimeBudget,
+
+    ImWidgetsStyleVar_TreeViewSize,
+
+    ImWidgetsStyleVar_LinePlotSize,
+    ImWidgetsStyleVar_LinePlotThickness,
+
+    ImWidgetsStyleVar_HistogramSize,
+
+    ImWidgetsStyleVar_HeatmapSize,
+
+    ImWidgetsStyleVar_SparklineSize,
+
+    ImWidgetsStyleVar_ScatterPlotSize,
+    ImWidgetsStyleVar_ScatterPlotMarkerSize,
+
+    ImWidgetsStyleVar_FlameGraphSize,
+    ImWidgetsStyleVar_FlameGraphRowHeight,
+
+    ImWidgetsStyleVar_TimelineSize,
+    ImWidgetsStyleVar_TimelineLaneHeight,
+
+    ImWidgetsStyleVar_HexViewerSize,
+
+    ImWidgetsStyleVar_FuzzySearchListHeight,
+    ImWidgetsStyleVar_CommandPaletteWidth,
+
+    ImWidgetsStyleVar_ToggleGridCellSize,
+    ImWidgetsStyleVar_ToggleGridSpacing,
+
+    ImWidgetsStyleVar_ProgressListRowHeight,
+    ImWidgetsStyleVar_ProgressListLabelWidth,
+    ImWidgetsStyleVar_COUNT
+};
+
 typedef int ImToggleFlags;
 typedef int ImRadioButtonGroupFlags;
 typedef int ImProgressBarFLags;
 typedef int ImSpinnerFlags;
 typedef int ImCalendarFlags;
+typedef int ImRichTextFlags;
+typedef int ImLogViewerFlags;
+typedef int ImDataGridFlags;
+typedef int ImTreeViewFlags;
+typedef int ImLinePlotFlags;
+typedef int ImHistogramFlags;
+typedef int ImHeatmapFlags;
+typedef int ImSparklineFlags;
+typedef int ImScatterPlotFlags;
+typedef int ImFlameGraphFlags;
+typedef int ImTimelineFlags;
+typedef int ImHexViewerFlags;
+typedef int ImFuzzySearchFlags;
+typedef int ImToggleGridFlags;
+typedef int ImProgressListFlags;
+typedef int ImProgressItemState;
+typedef int ImTaskPriority;
+typedef int ImWidgetsCol;
+typedef int ImWidgetsStyleVar;
+
+typedef double      (*ImDataGridValueGetter)(void* user_data, int row);
+typedef const char* (*ImDataGridTextGetter)(void* user_data, int row, char* buf, int buf_size);
+
+/* Children reported by a TreeView loader, labels are copied */
+struct ImTreeViewChildren {
+    ImVector<ImU64> Ids;
+    ImVector<int>   LabelOffsets;
+    ImVector<char>  Labels;
+    ImVector<bool>  HasChildren;
+
+    void Add(ImU64 id, const char* label, bool has_children = false) {
+        Ids.push_back(id);
+        LabelOffsets.push_back(Labels.Size);
+        for (const char* p = label; *p; p++)
+            Labels.push_back(*p);
+        Labels.push_back(0);
+        HasChildren.push_back(has_children);
+    }
+};
+
+typedef void (*ImTreeViewLoadChildrenFn)(void* user_data, ImU64 node_id, ImTreeViewChildren* out);
+
+/*
+    One column of a DataGrid, read in place (rows are never copied or moved):
+    - a span: Data points at row 0, rows are Stride bytes apart (0 = tightly packed DataType values),
+    - or callbacks: GetValue for numbers and/or GetText for strings. Sorting calls them from worker threads.
+*/
+struct ImDataGridColumn {
+    const char*             Name;
+    ImGuiDataType           DataType;
+    const void*             Data;
+    int                     Stride;
+    ImDataGridValueGetter   GetValue;
+    ImDataGridTextGetter    GetText;
+    void*                   UserData;
+    const char*             Format;     // printf format for numbers, nullptr for the data type's default
+};
+/*
+    Single-producer/single-consumer ring buffer of float samples for live plots. One thread pushes, the UI thread reads
+    through LinePlot() or the accessors below without locks or copies. Keeps the last 'capacity' samples plus a min/max
+    pyramid over power-of-two buckets that is updated as samples arrive, so a plot of any width costs O(pixels).
+    Sample indices are absolute (0 is the first sample ever pushed); storage is rounded up to a power of two with a
+    quarter of headroom, pushing more than capacity / 4 samples while the UI reads a frame may tear old samples.
+*/
+struct ImTimeSeries {
+    ImTimeSeries(int capacity);
+    ~ImTimeSeries();
+    ImTimeSeries(const ImTimeSeries&) = delete;
+    ImTimeSeries& operator=(const ImTimeSeries&) = delete;
+
+    /* Producer thread */
+    void    Push(float value);
+    void    Push(const float* values, int count);
+
+    /* Consumer thread */
+    ImU64   Size() const;       // Samples pushed so far, the readable ones are [Size() - Count(), Size())
+    int     Count() const;
+    int     GetSpans(ImU64 first, ImU64 last, const float** out_spans, int* out_counts) const;     // 1 or 2 spans when wrapping
+    bool    GetMinMax(ImU64 first, ImU64 last, float* out_min, float* out_max) const;               // O(log(last - first))
+    ImVec2  GetBucket(int level, ImU64 bucket, ImU64 size) const;   // Min/max of samples [bucket << level, (bucket + 1) << level) among the first 'size'
+
+    static constexpr int MinLevel = 3;              // Buckets of 8 samples and coarser are stored, finer ones read the samples
+    int                 Capacity;
+    int                 Mask;
+    int                 MaxLevel;
+    float*              Data;
+    ImVec2*             Pyramid;
+    int                 LevelOffsets[64] = {};
+    ImVec2              Pending[64] = {};       // Producer side: partial bucket of each level
+    std::atomic<ImU64>  Head{ 0 };
+
+private:
+    void    Write(ImU64 index, float value);
+    void    CompleteBucket(int level, ImU64 bucket, ImVec2 min_max);
+};
+
+/* One frame of a profile. Parents come before their children, siblings are laid out left to right in array order */
+struct ImFlameGraphNode {
+    int     Parent;     // -1 for roots
+    int     Name;       // Id from ImFlameGraphNames::Intern()
+    float   Total;      // Inclusive cost
+    float   Self;       // Exclusive cost
+};
+
+/* Interned node names, each distinct string is stored once and keeps its id */
+struct ImFlameGraphNames {
+    ImVector<char>  Buffer;
+    ImVector<int>   Offsets;
+    ImGuiStorage    Lookup;     // Hash -> id + 1, collisions probe the next hash
+
+    int         Intern(const char* name, const char* name_end = nullptr);
+    int         Size() const { return Offsets.Size; }
+    const char* Get(int id) const { return Buffer.Data + Offsets[id]; }
+    const char* GetEnd(int id) const { return Buffer.Data + (id + 1 < Offsets.Size ? Offsets[id + 1] : Buffer.Size) - 1; }
+};
+
+/* One span of a Timeline, the array is read in place */
+struct ImTimelineSpan {
+    double      Start;
+    double      End;
+    int         Lane;       // Row, spans with a negative lane are skipped
+    ImU32       Color;      // 0 for ImTimelineSpanColor
+    const char* Label;      // Optional, must outlive the span
+};
+
+/* One row of a ProgressList */
+struct ImProgressItem {
+    ImU64               Current;
+    ImU64               Total;
+    ImProgressItemState State;
+    const char*         Label;      // Optional, "#index" when null
+};
+
+/* Reads row 'index' into out, e.g. from atomics updated by worker threads */
+typedef void (*ImProgressListGetItemFn)(void* user_data, int index, ImProgressItem* out);
+
+/* Fills the private draw list of one ImWidgets::ParallelDraw() job, runs on a worker thread */
+typedef void (*ImDrawJobFn)(void* user_data, int job_index, ImDrawList* draw_list);
+
+/* Counters of one task queue since startup, times in milliseconds */
+struct ImTaskQueueStats {
+    ImU64   Submitted;
+    ImU64   Completed;
+    ImU64   Dropped;        // Never ran: owner went stale or the job was cancelled
+    ImU64   Stolen;         // Completed by another worker than the one it was queued on
+    int     Pending;        // Queued or running
+    float   AvgWaitMs;      // Moving average of queued -> started
+    float   MaxWaitMs;
+    float   AvgRunMs;
+};
+
+/* Frame arena usage of the current ImGui context, in bytes */
+struct ImFrameArenaStats {
+    size_t  Used;           // Allocated this frame so far
+    size_t  LastFrameUsed;
+    size_t  HighWater;      // Most any frame used
+    size_t  Capacity;       // Blocks held for this frame and the previous one
+    int     Blocks;
+};
+
+/*
+    printf-style format parsed once into literal runs and conversions, then applied to an array of doubles without
+    parsing again. Each conversion consumes the next argument, missing ones read as 0. %d %i %u %f and %.Nf (N <= 9)
+    without flags or width use the ImWidgets::Format* functions, any other conversion goes to snprintf on its own.
+*/
+struct ImCompiledFormat {
+    enum OpKind { OpKind_Literal, OpKind_Signed, OpKind_Unsigned, OpKind_Fixed, OpKind_PrintfInteger, OpKind_PrintfDouble };
+    struct Op {
+        OpKind  Kind;
+        int     Precision;      // Decimals of OpKind_Fixed
+        int     Begin, End;     // Literal text, or zero-terminated printf spec, in Text
+    };
+    ImVector<Op>    Ops;
+    ImVector<char>  Text;
+
+    ImCompiledFormat() {}
+    ImCompiledFormat(const char* format) { Compile(format); }
+    void    Compile(const char* format);
+    int     Format(char* buf, int buf_size, const double* args, int args_count) const;  // Returns the length, always zero-terminates
+};
+
 typedef int ImGuiTabBarFlags;
 
 /*
@@ -96,11 +623,31 @@ typedef int ImGuiTabBarFlags;
     - Collapsible Card
     - Tab Strip with Close Buttons → like browser tabs.
     - Notification Toasts
-    - Rich Text
 */
 
 namespace ImWidgets{
-    ImWidgetsStyle& GetStyle();
+    /* Context */
+    /*
+        Style, widget states, caches and the frame arena belong to the current ImGui context: they are created on its
+        first use and freed by ImGui::DestroyContext(). Contexts built on separate threads (with GImGui made
+        thread_local in imconfig.h) share no widget state, only the task pool, which has its own locking.
+    */
+    ImWidgetsStyle& GetStyle();     // Style of the current ImGui context
+
+    /* Style Stack */
+    /*
+        Scoped changes to single style fields, e.g. one toggle in its own color, restored by the matching pop. Backups
+        go to stacks of the context that stop allocating once grown to the deepest nesting. Widgets read colors packed
+        to ImU32 once per field, converted again only when that field (or ImGui's style alpha) changed, whether by a
+        push or a write through GetStyle(); a pop restores the packed value along with the field.
+    */
+    void    PushStyleColor(ImWidgetsCol idx, ImU32 col);
+    void    PushStyleColor(ImWidgetsCol idx, const ImVec4& col);
+    void    PopStyleColor(int count = 1);
+    void    PushStyleVar(ImWidgetsStyleVar idx, float val);
+    void    PushStyleVar(ImWidgetsStyleVar idx, const ImVec2& val);
+    void    PopStyleVar(int count = 1);
+    ImU32   GetColorU32(ImWidgetsCol idx, float alpha_mul = 1.0f);     // Style color with ImGui's style alpha applied
     /* Toggle Switch */
     bool ToggleSwitch(const char* label, bool* v, ImToggleFlags flags = ImToggleFlags_None);
 
@@ -109,6 +656,7 @@ namespace ImWidgets{
 
     /* Progress bar */
     void ProgressBar(const char* label, float min, float max, float current, ImToggleFlags flags = ImProgressBarFlags_None);
+    void ProgressBar(const char* label, float min, float max, float current, const char* format, ImToggleFlags flags = ImProgressBarFlags_None);   // format gets current, max and percent, e.g. "%.1f / %.1f MB"
 
     /* Spinner */
     void Spinner(const char* label, ImSpinnerFlags flags = ImSpinnerFlags_None);
@@ -119,6 +667,212 @@ namespace ImWidgets{
     */
     void Calendar(const char* label, int& day, int& month, int& year, ImCalendarFlags flags = ImCalendarFlags_None);
 
+    /* Rich Text */
+    /*
+        Markup: [b]bold[/b], [i]italic[/i], [color=RRGGBB(AA)]..[/color], [size=1.5]..[/size], [url=target]..[/url], "[[" for a literal '['.
+        The text is parsed and laid out once, then cached until it, the wrap width or the font changes; appended text only
+        re-lays out its last paragraph. The text is not read again while its pointer, length and text_version stay the
+        same: bump text_version after editing a buffer in place other than by appending. Returns true when a link is
+        clicked, its target is written to out_link.
+    */
+    bool RichText(const char* label, const char* text, const char* text_end = nullptr, const char** out_link = nullptr, ImRichTextFlags flags = ImRichTextFlags_None, int text_version = 0);
+
+    /* Log Viewer */
+    /*
+        Indexes line starts of the file at 'path' on a background thread, the index costs 8 bytes per line. Appends are
+        followed (inotify on Linux, polling elsewhere) and only visible lines are read and drawn. The file is read, not
+        mapped, so truncating it in place (logrotate's copytruncate) just starts the index over.
+        A size of 0 in ImLogViewerSize fills the available region. ImLogViewerFlags_Search adds a find bar whose
+        substring/regex search runs on worker threads over the file as it was when the search started.
+    */
+    void LogViewer(const char* label, const char* path, ImLogViewerFlags flags = ImLogViewerFlags_None);
+
+    /* Data Grid */
+    /*
+        Table over columnar data of any size: only visible rows are submitted, sorting runs on worker threads over a
+        row index, and filtering is spread over frames (ImDataGridFilterTimeBudget milliseconds each). Appending rows
+        (growing rows_count) is incremental; bump data_version when existing rows change.
+    */
+    void DataGrid(const char* label, const ImDataGridColumn* columns, int columns_count, int rows_count, int data_version = 0, ImDataGridFlags flags = ImDataGridFlags_None);
+
+    /* Tree View */
+    /*
+        Tree whose children are loaded on demand: load_children(user_data, node_id, out) is called on a worker thread
+        the first time a node is expanded (node_id 0 for the root) while a spinner row stands in for the children.
+        Visible rows are kept flattened and updated on expand/collapse, only rows in view are submitted.
+        Returns true when the selection changed.
+    */
+    bool TreeView(const char* label, ImTreeViewLoadChildrenFn load_children, void* user_data, ImU64* selected_id = nullptr, ImTreeViewFlags flags = ImTreeViewFlags_None);
+
+    /* Line Plot */
+    /*
+        Draws at most two points per pixel column whatever values_count is: samples are reduced to min/max buckets
+        (power-of-two sized, at least one pixel wide) that are cached across frames and merged when zooming out.
+        Appending samples only reads the new ones; bump values_version when existing samples change.
+        Mouse wheel zooms, dragging pans and double-click fits the whole series again.
+    */
+    void LinePlot(const char* label, const float* values, int values_count, int values_version = 0, ImLinePlotFlags flags = ImLinePlotFlags_None);
+    void LinePlot(const char* label, const ImTimeSeries& series, ImLinePlotFlags flags = ImLinePlotFlags_None);    // Follows the latest samples
+
+    /*
+        For series too large to scan even once per zoom (up to billions of samples): builds a min/max/mean pyramid over
+        the samples on worker threads, then every zoom level reads the pyramid level matching it in O(pixels). The plot
+        fills in as the build progresses and appends only build the new part. The pyramid costs about 0.75 bytes per
+        sample and lives in memory, or in the file at lod_path (rewritten on each build) to keep it out of RAM.
+        values must stay valid while the pyramid builds; bump values_version when existing samples change.
+    */
+    void LinePlotLod(const char* label, const float* values, ImU64 values_count, int values_version = 0, const char* lod_path = nullptr, ImLinePlotFlags flags = ImLinePlotFlags_None);
+
+    /* Histogram */
+    /*
+        Bins values into bins_count half-open bins over [range_min, range_max), or over the data's extent when range_min >= range_max.
+        Counts are cached per (values_version, range, bins_count) and appended samples are binned on their own, unless they
+        widen an automatic range. Small appends are binned right away; anything larger is binned with SIMD across threads on
+        the task pool while the previous bins stay on screen, so values must stay valid until it catches up. Bars are drawn
+        as one batch of quads.
+    */
+    void Histogram(const char* label, const float* values, int values_count, int bins_count = 64, float range_min = 0.0f, float range_max = 0.0f, int values_version = 0, ImHistogramFlags flags = ImHistogramFlags_None);
+
+    /* Heatmap */
+    /*
+        Row-major grid of columns x rows values drawn as one textured quad. Cells are colormapped through a 256 entry
+        lookup table (ImHeatmapLow/Mid/HighColor over [scale_min, scale_max]) into a texture owned by the widget, which
+        needs a renderer backend with ImGuiBackendFlags_RendererHasTextures. The whole grid is colormapped again when
+        values_version, the scale or the colors change; for cells changed in place, call HeatmapInvalidate() beforehand
+        and only those cells are colormapped and uploaded.
+    */
+    void Heatmap(const char* label, const float* values, int columns, int rows, float scale_min, float scale_max, int values_version = 0, ImHeatmapFlags flags = ImHeatmapFlags_None);
+    void HeatmapInvalidate(const char* label, int x, int y, int w, int h);
+
+    /* Sparkline */
+    /*
+        Inline mini-chart sized like a frame (ImSparklineSize, 0 = item width / frame height), decimated to one 1px column per pixel
+        and cached per (values_version, values_count, size). Between BeginSparklines() and EndSparklines() the geometry of
+        every sparkline is collected and emitted at EndSparklines() with one reservation per window, call it after EndTable()
+        when sparklines are in a table.
+    */
+    void BeginSparklines();
+    void EndSparklines();
+    void Sparkline(const char* label, const float* values, int values_count, int values_version = 0, ImSparklineFlags flags = ImSparklineFlags_None);
+
+    /* Scatter Plot */
+    /*
+        Up to ImScatterPlotMaxMarkers points are drawn as markers. Above that, points are counted per pixel on worker threads
+        whenever the view settles and drawn as a log-density texture (or ImScatterPlotFlags_BinnedMarkers: one marker per
+        bin, at most ImScatterPlotMaxMarkers). A grid index built on a worker thread per points_version answers hover.
+        Mouse wheel zooms, dragging pans and double-click fits all points again.
+    */
+    void ScatterPlot(const char* label, const float* xs, const float* ys, int points_count, int points_version = 0, ImScatterPlotFlags flags = ImScatterPlotFlags_None);
+
+    /* Flame Graph */
+    /*
+        Icicle (or ImFlameGraphFlags_Inverted flame) graph of a profile. Child lists and offsets are built on a worker thread
+        per nodes_version, then only the visible range is laid out each frame: runs of nodes narrower than a pixel are merged
+        into one rectangle and their subtrees skipped, labels are truncated using cached name widths.
+        Mouse wheel zooms, dragging pans, clicking a node zooms to it and double-click shows everything again.
+    */
+    void FlameGraph(const char* label, const ImFlameGraphNode* nodes, int nodes_count, const ImFlameGraphNames& names, int nodes_version = 0, ImFlameGraphFlags flags = ImFlameGraphFlags_None);
+
+    /* Timeline */
+    /*
+        One row per lane. Each lane's spans are sorted by start on a worker thread per spans_version, with the max end per
+        bucket of spans kept in a binary tree, so the spans overlapping the view are found without scanning the others.
+        Spans narrower than a pixel are merged into density blocks of one pixel column, everything is drawn as batched
+        quads and labels are truncated to their span. With ImTimelineFlags_DateAxis the axis shows the Calendar's
+        "day / month / year" and times of day, DateToTime() converts a Calendar date for TimelineSetView().
+        Mouse wheel zooms, dragging pans and scrolls lanes, double-click shows everything again.
+    */
+    void Timeline(const char* label, const ImTimelineSpan* spans, int spans_count, int spans_version = 0, ImTimelineFlags flags = ImTimelineFlags_None);
+    void TimelineSetView(const char* label, double time_min, double time_max);
+    double DateToTime(int day, int month, int year);                    // Seconds since 1970-01-01 UTC at midnight, month 1-12 like Calendar
+    void TimeToDate(double time, int& day, int& month, int& year);
+
+    /* Hex Viewer */
+    /*
+        Hex and ASCII columns, 16 bytes per row, over a file (opened instantly, only visible rows are read) or
+        over size bytes at data, which must stay valid. Only visible rows are converted, a vector at a time,
+        into a scratch buffer reused across frames; the rows are 64-bit so files of any size scroll. Click, drag or
+        shift-click to select, Ctrl+C copies the selection as hex. Hovering a byte shows the integers and floats starting
+        there. ImHexViewerFlags_Search adds a find bar for byte patterns ("DE AD BE EF") or quoted text that runs on
+        worker threads.
+    */
+    void HexViewer(const char* label, const char* path, ImHexViewerFlags flags = ImHexViewerFlags_None);
+    void HexViewer(const char* label, const void* data, ImU64 size, ImHexViewerFlags flags = ImHexViewerFlags_None);
+    bool HexViewerGetSelection(const char* label, ImU64* offset, ImU64* size);      // Returns false when nothing is selected
+    void HexViewerSetSelection(const char* label, ImU64 offset, ImU64 size);        // Also scrolls it into view
+
+    /* Fuzzy Combo / Command Palette */
+    /*
+        Searchable item lists for 100k+ items. The query's letters must appear in order; matches are ranked on consecutive
+        letters and word starts and the best ImFuzzySearchMaxResults are listed, only visible rows are drawn. Items are
+        first rejected on a per-item letter mask a vector at a time. Large sets are scored on worker threads while the
+        previous results stay listed, and a query that extends the previous one only rescans its matches.
+        items must stay valid; bump items_version when they change. Up/Down and Enter pick from the keyboard.
+    */
+    bool FuzzyCombo(const char* label, int* current, const char* const items[], int items_count, int items_version = 0, ImFuzzySearchFlags flags = ImFuzzySearchFlags_None);
+    bool CommandPalette(const char* label, bool* p_open, int* selected, const char* const items[], int items_count, int items_version = 0, ImFuzzySearchFlags flags = ImFuzzySearchFlags_None);  // Opens while *p_open, returns true when an item is picked
+
+    /* Toggle Grid */
+    /*
+        rows x columns switches bound to a packed bitset: cell (row, column) is bit row * columns + column of bits, 32 per
+        word like ImBitArray. The grid is one item: the hovered cell comes from the mouse position, only cells in view
+        are drawn (as batched quads, in the ToggleSwitch colors) and only cells toggled in the last moments animate.
+        Click toggles a cell, dragging paints the same value over others. Labels, when given, are shown in the tooltip.
+    */
+    bool ToggleGrid(const char* label, ImU32* bits, int columns, int rows, const char* const row_labels[] = nullptr, const char* const column_labels[] = nullptr, ImToggleGridFlags flags = ImToggleGridFlags_None);
+
+    /* Progress List */
+    /*
+        One bar per job for thousands of jobs: rows are placed arithmetically and only visible ones are read, their labels
+        are formatted without printf into the frame arena and all bars go out in one batch of quads.
+        The summary line counts jobs per state and sums Current/Total over every row. Rows can come from an array or
+        from get_item, which can read atomics.
+    */
+    void ProgressList(const char* label, const ImProgressItem* items, int items_count, ImProgressListFlags flags = ImProgressListFlags_None);
+    void ProgressList(const char* label, ImProgressListGetItemFn get_item, void* user_data, int items_count, ImProgressListFlags flags = ImProgressListFlags_None);
+
+    /* Formatting */
+    /*
+        printf-free number formatting for labels redrawn every frame, two digits per division through a digit-pair table.
+        Like std::to_chars nothing is zero-terminated and the end is returned. Integers need 20 chars of room and fixed
+        point 24 + decimals; values past 1e20 are written as %e.
+    */
+    char*   FormatUnsigned(char* out, ImU64 v);
+    char*   FormatSigned(char* out, ImS64 v);
+    char*   FormatFixed(char* out, double v, int decimals);           // The digits of "%.*f", decimals <= 9
+    char*   FormatPercent(char* out, float fraction, int decimals = 0); // 0.5f -> "50%"
+
+    /* Parallel Drawing */
+    /*
+        Opt-in multi-threaded geometry for heavy custom drawing. job(user_data, i, fragment) runs for every i in
+        [0, jobs_count) on the worker pool and the calling thread, each into a private ImDrawList that shares draw_list's
+        ImDrawListSharedData, clip rect and texture. The fragments are then appended to draw_list in job order, so the
+        result is what drawing the jobs one after the other would give. Jobs may use any primitive but text (glyphs are
+        baked on demand, which is not thread-safe) and callbacks; draw labels after ParallelDraw() returns.
+    */
+    void    ParallelDraw(ImDrawList* draw_list, int jobs_count, ImDrawJobFn job, void* user_data);
+
+    /* Task Pool */
+    /*
+        Every background job (sorting, indexing, search, LOD and layout builds) and ParallelDraw() share one
+        work-stealing pool. Jobs are owned by the widget that started them: they run ahead of other work while it is
+        drawn, fall behind when it is not, and are cancelled after 60 frames out of sight, to restart when it comes back.
+    */
+    void    SetWorkerThreadCount(int count);    // Workers besides the calling thread (at least 1), -1 (default) for hardware threads - 1
+    void    GetTaskQueueStats(ImTaskQueueStats out_stats[ImTaskPriority_COUNT]);
+
+    /* Frame Arena */
+    /*
+        Scratch memory for widget internals and custom widgets, one arena per ImGui context, UI thread only. Allocating
+        bumps a pointer, nothing is freed: the arena holds two frames and recycles the older one at NewFrame(), so what
+        is allocated stays valid through this frame's render and the whole next frame. Blocks outgrown in a frame are
+        merged into one the next time round, a steady frame then allocates from a single warm block.
+    */
+    void*   FrameAlloc(size_t size, size_t alignment = 16);
+    char*   FrameStrdup(const char* text, const char* text_end = nullptr);
+    char*   FrameFormat(const char* fmt, ...) IM_FMTARGS(1);
+    void    GetFrameArenaStats(ImFrameArenaStats* out_stats);
+
     /* Tab strip */
     void TabStrip(const char* label, ImGuiTabBarFlags flags = ImGuiTabBarFlags_None);
     void Tab(const char* label, bool* p_open = nullptr);
@@ -1,14 +1,47 @@
 #include "im_widgets.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <unordered_map>
 #include <chrono>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
 #include <ctime>
+#include <deque>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <imgui_internal.h>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
 #include <iostream>
 
-static ImWidgetsStyle GImWidgetsStyle = {
+static const ImWidgetsStyle GImWidgetsDefaultStyle = {
     /* Toggle switch styling  */
     10.0f,
     ImVec2(40, 20),
@@ -51,67 +84,501 @@ static ImWidgetsStyle GImWidgetsStyle = {
     ImVec4(0.50f, 0.50f, 0.60f, 0.4f),
     ImVec4(0.20f, 0.45f, 0.85f, 0.85f),
     ImVec4(0.25f, 0.55f, 0.95f, 0.9f),
-    ImVec4(0.10f, 0.10f, 0.12f, 0.5f)
+    ImVec4(0.10f, 0.10f, 0.12f, 0.5f),
+    ImVec4(0.0f, 0.0f, 0.0f, 0.0f),
+
+    /* Rich Text */
+    0.2f,
+    ImVec4(0.35f, 0.65f, 1.0f, 1.0f),
+    ImVec4(0.55f, 0.80f, 1.0f, 1.0f),
+
+    /* Log Viewer */
+    ImVec2(0, 0),
+    ImVec4(1.00f, 0.40f, 0.40f, 1.0f),
+    ImVec4(1.00f, 0.80f, 0.30f, 1.0f),
+    ImVec4(0.85f, 0.87f, 0.90f, 1.0f),
+    ImVec4(0.55f, 0.55f, 0.60f, 1.0f),
+
+    /* Data Grid */
+    ImVec2(0, 0),
+    4.0f,
+
+    /* Tree View */
+    ImVec2(0, 0),
+    ImVec4(0.75f, 0.75f, 0.75f, 1.0f),
+
+    /* Line Plot */
+    ImVec2(0, 0),
+    1.0f,
+    ImVec4(0.2f, 0.8f, 0.4f, 1.0f),
+    ImVec4(0.10f, 0.10f, 0.12f, 1.0f),
+
+    /* Histogram */
+    ImVec2(0, 0),
+    ImVec4(0.2f, 0.8f, 0.4f, 1.0f),
+    ImVec4(0.5f, 1.0f, 0.6f, 1.0f),
+    ImVec4(0.10f, 0.10f, 0.12f, 1.0f),
+
+    /* Heatmap */
+    ImVec2(0, 0),
+    ImVec4(0.07f, 0.04f, 0.25f, 1.0f),
+    ImVec4(0.75f, 0.20f, 0.40f, 1.0f),
+    ImVec4(1.00f, 0.95f, 0.55f, 1.0f),
+
+    /* Sparkline */
+    ImVec2(0, 0),
+    ImVec4(0.2f, 0.8f, 0.4f, 1.0f),
+
+    /* Scatter Plot */
+    ImVec2(0, 0),
+    3.0f,
+    50000,
+    ImVec4(0.2f, 0.8f, 0.4f, 1.0f),
+    ImVec4(0.10f, 0.10f, 0.12f, 1.0f),
+
+    /* Flame Graph */
+    ImVec2(0, 0),
+    0.0f,
+    ImVec4(0.95f, 0.75f, 0.30f, 1.0f),
+    ImVec4(0.85f, 0.30f, 0.20f, 1.0f),
+    ImVec4(0.45f, 0.45f, 0.50f, 1.0f),
+    ImVec4(0.05f, 0.05f, 0.05f, 1.0f),
+    ImVec4(0.10f, 0.10f, 0.12f, 1.0f),
+
+    /* Timeline */
+    ImVec2(0, 0),
+    0.0f,
+    ImVec4(0.26f, 0.59f, 0.98f, 1.0f),
+    ImVec4(0.26f, 0.59f, 0.98f, 1.0f),
+    ImVec4(0.95f, 0.95f, 0.95f, 1.0f),
+    ImVec4(0.35f, 0.35f, 0.40f, 1.0f),
+    ImVec4(0.10f, 0.10f, 0.12f, 1.0f),
+
+    /* Hex Viewer */
+    ImVec2(0, 0),
+    ImVec4(0.50f, 0.50f, 0.55f, 1.0f),
+    ImVec4(0.75f, 0.85f, 0.60f, 1.0f),
+    ImVec4(0.26f, 0.59f, 0.98f, 0.45f),
+    ImVec4(0.95f, 0.75f, 0.30f, 0.45f),
+    ImVec4(0.9f, 0.3f, 0.3f, 1.0f),
+
+    /* Fuzzy Search */
+    1000,
+    0.0f,
+    0.0f,
+    ImVec4(0.95f, 0.75f, 0.30f, 1.0f),
+
+    /* Toggle Grid */
+    ImVec2(24, 12),
+    2.0f,
+
+    /* Progress List */
+    0.0f,
+    160.0f,
+    ImVec4(0.35f, 0.35f, 0.40f, 1.0f),
+    ImVec4(0.26f, 0.59f, 0.98f, 1.0f),
+    ImVec4(0.85f, 0.25f, 0.25f, 1.0f)
+};
+
+/*
+    CONTEXT
+*/
+
+// Everything a widget keeps between frames lives in the ImWidgetsContext of its ImGui context, so widgets of
+// contexts built on different threads share nothing. Each kind of data has a slot, filled on first use.
+enum ImWidgetsContextSlot_ {
+    ImWidgetsContextSlot_FrameArena,
+    ImWidgetsContextSlot_TaskOwners,
+    ImWidgetsContextSlot_ToggleSwitch,
+    ImWidgetsContextSlot_RadioButtonGroup,
+    ImWidgetsContextSlot_ProgressBarLabels,
+    ImWidgetsContextSlot_ProgressBarFormats,
+    ImWidgetsContextSlot_Calendar,
+    ImWidgetsContextSlot_RichText,
+    ImWidgetsContextSlot_LogViewer,
+    ImWidgetsContextSlot_DataGrid,
+    ImWidgetsContextSlot_TreeView,
+    ImWidgetsContextSlot_LinePlot,
+    ImWidgetsContextSlot_TimeSeriesPlot,
+    ImWidgetsContextSlot_LinePlotLod,
+    ImWidgetsContextSlot_Histogram,
+    ImWidgetsContextSlot_Heatmap,
+    ImWidgetsContextSlot_Sparkline,
+    ImWidgetsContextSlot_SparklineBatch,
+    ImWidgetsContextSlot_ScatterPlot,
+    ImWidgetsContextSlot_FlameGraph,
+    ImWidgetsContextSlot_Timeline,
+    ImWidgetsContextSlot_HexViewer,
+    ImWidgetsContextSlot_FuzzyCombo,
+    ImWidgetsContextSlot_CommandPalette,
+    ImWidgetsContextSlot_ToggleGrid,
+    ImWidgetsContextSlot_ParallelDraw,
+    ImWidgetsContextSlot_COUNT
+};
+typedef int ImWidgetsContextSlot;
+
+// Contents of a slot. NewFrame() runs from the context's NewFramePre hook, on the thread calling ImGui::NewFrame()
+struct ImWidgetsContextData {
+    virtual ~ImWidgetsContextData() {}
+    virtual void NewFrame() {}
+};
+
+template<typename T>
+struct ImWidgetsContextValue : ImWidgetsContextData {
+    T       Value;
 };
 
+// Packed form of one style color, valid while the field still holds Source and ImGui's style alpha is Alpha
+struct ImWidgetsCompiledColor {
+    ImVec4          Source;
+    float           Alpha = -1.0f;
+    ImU32           Packed = 0;
+};
+
+// Value replaced by ImWidgets::PushStyleColor(), with its compiled color so that popping recompiles nothing
+struct ImWidgetsColorMod {
+    ImWidgetsCol    Col;
+    ImVec4          BackupValue;
+    ImWidgetsCompiledColor BackupCompiled;
+};
+
+// Value replaced by ImWidgets::PushStyleVar()
+struct ImWidgetsStyleMod {
+    ImWidgetsStyleVar VarIdx;
+    float           BackupFloat[2];
+};
+
+struct ImWidgetsContext {
+    ImWidgetsStyle  Style = GImWidgetsDefaultStyle;
+    ImVector<ImWidgetsColorMod> ColorStack;         // Never shrinks, pushing stops allocating after warm-up
+    ImVector<ImWidgetsStyleMod> StyleVarStack;
+    ImWidgetsCompiledColor CompiledColors[ImWidgetsCol_COUNT];
+    std::unique_ptr<ImWidgetsContextData> Slots[ImWidgetsContextSlot_COUNT];
+
+    // Slots are destroyed last to first: widget states, which wait for their jobs, before the task owners and the arena
+    ~ImWidgetsContext() {
+        for (int slot = ImWidgetsContextSlot_COUNT - 1; slot >= 0; slot--)
+            Slots[slot].reset();
+    }
+
+    void NewFrame() {
+        IM_ASSERT(ColorStack.Size == 0 && "Missing ImWidgets::PopStyleColor()");
+        IM_ASSERT(StyleVarStack.Size == 0 && "Missing ImWidgets::PopStyleVar()");
+        for (std::unique_ptr<ImWidgetsContextData>& data : Slots)
+            if (data)
+                data->NewFrame();
+    }
+};
+
+static void ImWidgetsContextNewFrameHook(ImGuiContext*, ImGuiContextHook* hook) {
+    ((ImWidgetsContext*)hook->UserData)->NewFrame();
+}
+
+static void ImWidgetsContextShutdownHook(ImGuiContext* ctx, ImGuiContextHook* hook) {
+    ImWidgetsContext* context = (ImWidgetsContext*)hook->UserData;
+    for (const ImGuiContextHook& other : ctx->Hooks)
+        if (other.UserData == context)
+            ImGui::RemoveContextHook(ctx, other.HookId);
+    delete context;
+}
+
+// ImWidgetsContext of the current ImGui context, created on first use. It is found through the hooks it installs
+// rather than a global map, so looking it up takes no lock
+static ImWidgetsContext& GetContext() {
+    ImGuiContext* ctx = ImGui::GetCurrentContext();
+    IM_ASSERT(ctx != nullptr && "No current ImGui context");
+    for (const ImGuiContextHook& hook : ctx->Hooks)
+        if (hook.Type == ImGuiContextHookType_NewFramePre && hook.Callback == ImWidgetsContextNewFrameHook)
+            return *(ImWidgetsContext*)hook.UserData;
+
+    ImWidgetsContext* context = new ImWidgetsContext();
+    ImGuiContextHook hook;
+    hook.Type = ImGuiContextHookType_NewFramePre;
+    hook.Callback = ImWidgetsContextNewFrameHook;
+    hook.UserData = context;
+    ImGui::AddContextHook(ctx, &hook);
+    hook.Type = ImGuiContextHookType_Shutdown;
+    hook.Callback = ImWidgetsContextShutdownHook;
+    ImGui::AddContextHook(ctx, &hook);
+    return *context;
+}
+
+template<typename T>
+static T& GetContextData(ImWidgetsContextSlot slot) {
+    std::unique_ptr<ImWidgetsContextData>& data = GetContext().Slots[slot];
+    if (!data)
+        data.reset(new T());
+    return *static_cast<T*>(data.get());
+}
+
+template<typename T>
+static T& GetContextValue(ImWidgetsContextSlot slot) {
+    return GetContextData<ImWidgetsContextValue<T>>(slot).Value;
+}
+
+// Per-widget states of one kind, by ID
+template<typename T>
+static std::unordered_map<ImGuiID, T>& GetStatePool(ImWidgetsContextSlot slot) {
+    return GetContextValue<std::unordered_map<ImGuiID, T>>(slot);
+}
+
+// Writes through the reference need no notification: a compiled color is only made again once its field differs
 ImWidgetsStyle& ImWidgets::GetStyle() {
-    return GImWidgetsStyle;
+    return GetContext().Style;
 }
 
 /*
-    UTILITIES
+    STYLE STACK
 */
 
-std::pair<std::string, bool> TrimTextToWidth(const char* text, float max_width) {
-    ImVec2 text_size = ImGui::CalcTextSize(text);
-        
-    if (text_size.x <= max_width) {
-        return {std::string(text), false};
-    }
-        
-    // Text needs trimming
-    std::string result;
-    const char* ptr = text;
-    float current_width = 0.0f;
-    
-    while (*ptr) {
-        // Get the width of the current character
-        ImVec2 char_size = ImGui::CalcTextSize(ptr, ptr + 1);
-        
-        // Check if adding this character would exceed the max width
-        if (current_width + char_size.x > max_width) {
-            break;
-        }
-        
-        result += *ptr;
-        current_width += char_size.x;
-        ptr++;
+// Offsets of the ImWidgetsCol_ fields in ImWidgetsStyle
+static const ImU32 GImWidgetsColOffsets[] = {
+    (ImU32)offsetof(ImWidgetsStyle, ImToggleSwitchOnColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImToggleSwitchOffColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImToggleSwitchKnobColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImToggleSwitchDisabledColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupActiveColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupInactiveColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupDisabledColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupActiveTextColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupInactiveTextColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupDisabledTextColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImProgressBarBgColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImProgressBarColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImProgressBarTextColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImSpinnerColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImCalendarTextColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImCalendarBorderStrongColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImCalendarBorderLightColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImCalendarSelectedCellColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImCalendarHoveredCellColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImCalendarActivePressFeedBack),
+    (ImU32)offsetof(ImWidgetsStyle, ImCalendarBgColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImRichTextLinkColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImRichTextLinkHoveredColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImLogViewerErrorColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImLogViewerWarningColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImLogViewerInfoColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImLogViewerDebugColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImTreeViewArrowColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImLinePlotLineColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImLinePlotBgColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHistogramBarColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHistogramBarHoveredColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHistogramBgColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHeatmapLowColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHeatmapMidColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHeatmapHighColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImSparklineColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImScatterPlotColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImScatterPlotBgColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImFlameGraphColdColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImFlameGraphHotColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImFlameGraphMergedColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImFlameGraphTextColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImFlameGraphBgColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImTimelineSpanColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImTimelineDensityColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImTimelineTextColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImTimelineAxisColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImTimelineBgColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHexViewerAddressColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHexViewerAsciiColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHexViewerSelectionColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHexViewerMatchColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImHexViewerErrorColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImFuzzySearchMatchColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImProgressListQueuedColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImProgressListDoneColor),
+    (ImU32)offsetof(ImWidgetsStyle, ImProgressListFailedColor),
+};
+static_assert(IM_ARRAYSIZE(GImWidgetsColOffsets) == ImWidgetsCol_COUNT, "ImWidgetsCol_ and GImWidgetsColOffsets[] differ");
+
+struct ImWidgetsStyleVarInfo {
+    ImU32   Count;      // 1: float, 2: ImVec2
+    ImU32   Offset;
+    float*  GetVarPtr(ImWidgetsStyle* style) const { return (float*)(void*)((unsigned char*)style + Offset); }
+};
+
+static const ImWidgetsStyleVarInfo GImWidgetsStyleVarInfo[] = {
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImToggleSwitchRadius) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImToggleSwitchSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupRadius) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupSpacing) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImRadioButtonGroupSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImProgressBarRadius) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImProgressBarCircleRadius) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImProgressBarCircleThickness) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImProgressBarSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImSpinnerRadius) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImSpinnerThickness) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImSpinnerSpeed) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImCalendarInnerWidth) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImCalendarOuterSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImRichTextItalicShear) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImLogViewerSize) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImDataGridSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImDataGridFilterTimeBudget) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImTreeViewSize) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImLinePlotSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImLinePlotThickness) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImHistogramSize) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImHeatmapSize) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImSparklineSize) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImScatterPlotSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImScatterPlotMarkerSize) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImFlameGraphSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImFlameGraphRowHeight) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImTimelineSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImTimelineLaneHeight) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImHexViewerSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImFuzzySearchListHeight) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImCommandPaletteWidth) },
+    { 2, (ImU32)offsetof(ImWidgetsStyle, ImToggleGridCellSize) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImToggleGridSpacing) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImProgressListRowHeight) },
+    { 1, (ImU32)offsetof(ImWidgetsStyle, ImProgressListLabelWidth) },
+};
+static_assert(IM_ARRAYSIZE(GImWidgetsStyleVarInfo) == ImWidgetsStyleVar_COUNT, "ImWidgetsStyleVar_ and GImWidgetsStyleVarInfo[] differ");
+
+static ImVec4& StyleColorRef(ImWidgetsStyle& style, ImWidgetsCol idx) {
+    return *(ImVec4*)(void*)((unsigned char*)&style + GImWidgetsColOffsets[idx]);
+}
+
+void ImWidgets::PushStyleColor(ImWidgetsCol idx, ImU32 col) {
+    PushStyleColor(idx, ImGui::ColorConvertU32ToFloat4(col));
+}
+
+void ImWidgets::PushStyleColor(ImWidgetsCol idx, const ImVec4& col) {
+    IM_ASSERT(idx >= 0 && idx < ImWidgetsCol_COUNT);
+    ImWidgetsContext& ctx = GetContext();
+    ImVec4& value = StyleColorRef(ctx.Style, idx);
+    ctx.ColorStack.push_back({ idx, value, ctx.CompiledColors[idx] });
+    value = col;
+}
+
+void ImWidgets::PopStyleColor(int count) {
+    ImWidgetsContext& ctx = GetContext();
+    IM_ASSERT(ctx.ColorStack.Size >= count && "Calling PopStyleColor() too many times");
+    for (; count > 0 && ctx.ColorStack.Size > 0; count--) {
+        const ImWidgetsColorMod& backup = ctx.ColorStack.back();
+        StyleColorRef(ctx.Style, backup.Col) = backup.BackupValue;
+        ctx.CompiledColors[backup.Col] = backup.BackupCompiled;
+        ctx.ColorStack.pop_back();
     }
-    
-    return {result, true};
 }
 
-std::string TrimTextWithEllipsis(const char* text, float max_width) {
-    static const char* ellipsis = "..";
-    ImVec2 ellipsis_size = ImGui::CalcTextSize(ellipsis);
+void ImWidgets::PushStyleVar(ImWidgetsStyleVar idx, float val) {
+    IM_ASSERT(idx >= 0 && idx < ImWidgetsStyleVar_COUNT);
+    const ImWidgetsStyleVarInfo& info = GImWidgetsStyleVarInfo[idx];
+    IM_ASSERT(info.Count == 1 && "Calling PushStyleVar() variant with wrong type");
+    ImWidgetsContext& ctx = GetContext();
+    float* var = info.GetVarPtr(&ctx.Style);
+    ctx.StyleVarStack.push_back({ idx, { var[0], 0.0f } });
+    var[0] = val;
+}
 
-    ImVec2 text_size = ImGui::CalcTextSize(text);
-    if (text_size.x <= max_width) {
-        return std::string(text);
+void ImWidgets::PushStyleVar(ImWidgetsStyleVar idx, const ImVec2& val) {
+    IM_ASSERT(idx >= 0 && idx < ImWidgetsStyleVar_COUNT);
+    const ImWidgetsStyleVarInfo& info = GImWidgetsStyleVarInfo[idx];
+    IM_ASSERT(info.Count == 2 && "Calling PushStyleVar() variant with wrong type");
+    ImWidgetsContext& ctx = GetContext();
+    float* var = info.GetVarPtr(&ctx.Style);
+    ctx.StyleVarStack.push_back({ idx, { var[0], var[1] } });
+    var[0] = val.x;
+    var[1] = val.y;
+}
+
+void ImWidgets::PopStyleVar(int count) {
+    ImWidgetsContext& ctx = GetContext();
+    IM_ASSERT(ctx.StyleVarStack.Size >= count && "Calling PopStyleVar() too many times");
+    for (; count > 0 && ctx.StyleVarStack.Size > 0; count--) {
+        const ImWidgetsStyleMod& backup = ctx.StyleVarStack.back();
+        const ImWidgetsStyleVarInfo& info = GImWidgetsStyleVarInfo[backup.VarIdx];
+        float* var = info.GetVarPtr(&ctx.Style);
+        for (ImU32 i = 0; i < info.Count; i++)
+            var[i] = backup.BackupFloat[i];
+        ctx.StyleVarStack.pop_back();
     }
+}
 
-    float available_width = max_width - ellipsis_size.x;
-    if (available_width <= 0.0f) {
-        return std::string(ellipsis);
+// Same as ImGui::GetColorU32(style color), converted again only when the field or ImGui's style alpha changed
+ImU32 ImWidgets::GetColorU32(ImWidgetsCol idx, float alpha_mul) {
+    IM_ASSERT(idx >= 0 && idx < ImWidgetsCol_COUNT);
+    ImWidgetsContext& ctx = GetContext();
+    const float alpha = ImGui::GetStyle().Alpha;
+    if (alpha_mul != 1.0f) {
+        ImVec4 col = StyleColorRef(ctx.Style, idx);
+        col.w *= alpha * alpha_mul;
+        return ImGui::ColorConvertFloat4ToU32(col);
     }
-    
+    const ImVec4& source = StyleColorRef(ctx.Style, idx);
+    ImWidgetsCompiledColor& compiled = ctx.CompiledColors[idx];
+    if (compiled.Alpha != alpha || memcmp(&compiled.Source, &source, sizeof(ImVec4)) != 0) {
+        compiled.Source = source;
+        compiled.Alpha = alpha;
+        compiled.Packed = ImGui::ColorConvertFloat4ToU32(ImVec4(source.x, source.y, source.z, source.w * alpha));
+    }
+    return compiled.Packed;
+}
+
+/*
+    UTILITIES
+*/
+
+// Longest prefix of text that fits max_width, copied to the frame arena when it had to be cut
+std::pair<const char*, bool> TrimTextToWidth(const char* text, float max_width) {
+    const char* text_end = text + strlen(text);
+    const char* fit_end = text;
+    ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), ImMax(max_width, 0.0f), 0.0f, text, text_end, &fit_end);
+    if (fit_end == text_end)
+        return {text, false};
+    return {ImWidgets::FrameStrdup(text, fit_end), true};
+}
+
+// text, or its longest prefix fitting max_width followed by "..", in the frame arena
+const char* TrimTextWithEllipsis(const char* text, float max_width) {
+    static const char* ellipsis = "..";
+    if (ImGui::CalcTextSize(text).x <= max_width)
+        return text;
+    const float available_width = max_width - ImGui::CalcTextSize(ellipsis).x;
+    if (available_width <= 0.0f)
+        return ellipsis;
     auto [trimmed, was_truncated] = TrimTextToWidth(text, available_width);
-    
-    if (was_truncated) {
-        return trimmed + ellipsis;
+    if (!was_truncated)
+        return trimmed;
+    return ImWidgets::FrameFormat("%s%s", trimmed, ellipsis);
+}
+
+// Allocation-free TrimTextWithEllipsis: draws the longest prefix of text that fits max_width followed by "..".
+// Pass the widths when they are cached, a negative width is measured.
+void DrawTextWithEllipsis(ImDrawList* draw_list, const ImVec2& pos, ImU32 color, const char* text, const char* text_end, float max_width, float text_width = -1.0f, float ellipsis_width = -1.0f) {
+    static const char* ellipsis = "..";
+    if (text_width < 0.0f)
+        text_width = ImGui::CalcTextSize(text, text_end).x;
+    if (text_width <= max_width) {
+        draw_list->AddText(pos, color, text, text_end);
+        return;
     }
-    
-    return trimmed;
+    if (ellipsis_width < 0.0f)
+        ellipsis_width = ImGui::CalcTextSize(ellipsis).x;
+    if (ellipsis_width > max_width)
+        return;
+
+    const char* fit_end = text;
+    ImVec2 fit_size = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), max_width - ellipsis_width, 0.0f, text, text_end, &fit_end);
+    draw_list->AddText(pos, color, text, fit_end);
+    draw_list->AddText(ImVec2(pos.x + fit_size.x, pos.y), color, ellipsis);
+}
+
+static inline int CountTrailingZeros(ImU32 v) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return (int)index;
+#else
+    return __builtin_ctz(v);
+#endif
 }
 
 void DrawCenteredText(ImDrawList* draw_list, const ImVec2& center, const char* text, ImU32 color) {
@@ -123,10 +590,332 @@ void DrawCenteredText(ImDrawList* draw_list, const ImVec2& center, const char* t
     draw_list->AddText(text_pos, color, text);
 }
 
+/*
+    FRAME ARENA
+*/
+
+// Bump allocator over two sets of blocks, one per frame: NewFrame() switches to the set of the frame before last
+struct ImFrameArena : ImWidgetsContextData {
+    static const size_t MinBlockSize = 64 * 1024;
+
+    struct Block {
+        char*   Data;
+        size_t  Size;
+    };
+    struct Frame {
+        ImVector<Block> Blocks;
+        int     Current = 0;
+        size_t  Offset = 0;
+        size_t  Used = 0;
+    };
+
+    Frame   Frames[2];
+    int     Index = 0;          // Frame receiving allocations
+    size_t  HighWater = 0;
+
+    ~ImFrameArena() {
+        for (Frame& frame : Frames)
+            for (Block& block : frame.Blocks)
+                IM_FREE(block.Data);
+    }
+
+    void* Alloc(size_t size, size_t alignment) {
+        Frame& frame = Frames[Index];
+        for (;;) {
+            if (frame.Current < frame.Blocks.Size) {
+                Block& block = frame.Blocks[frame.Current];
+                const size_t begin = (frame.Offset + alignment - 1) & ~(alignment - 1);
+                if (begin + size <= block.Size) {
+                    frame.Used += begin + size - frame.Offset;
+                    frame.Offset = begin + size;
+                    return block.Data + begin;
+                }
+                if (frame.Current + 1 < frame.Blocks.Size) {
+                    frame.Current++;
+                    frame.Offset = 0;
+                    continue;
+                }
+            }
+            // Out of room: a block twice the last one, so a frame needs few of them before they are merged
+            const size_t block_size = ImMax(ImMax(MinBlockSize, frame.Blocks.Size ? frame.Blocks.back().Size * 2 : 0), size + alignment);
+            const Block block = { (char*)IM_ALLOC(block_size), block_size };
+            frame.Blocks.push_back(block);
+            frame.Current = frame.Blocks.Size - 1;
+            frame.Offset = 0;
+        }
+    }
+
+    void NewFrame() override {
+        HighWater = ImMax(HighWater, Frames[Index].Used);
+        Index ^= 1;
+        Frame& frame = Frames[Index];
+        if (frame.Blocks.Size > 1) {
+            // One block for what that frame used, with some room to grow
+            for (Block& block : frame.Blocks)
+                IM_FREE(block.Data);
+            const size_t size = ImMax(MinBlockSize, frame.Used + frame.Used / 4);
+            frame.Blocks.resize(1);
+            frame.Blocks[0] = { (char*)IM_ALLOC(size), size };
+        }
+        frame.Current = 0;
+        frame.Offset = 0;
+        frame.Used = 0;
+    }
+};
+
+static ImFrameArena& GetFrameArena() {
+    return GetContextData<ImFrameArena>(ImWidgetsContextSlot_FrameArena);
+}
+
+// Uninitialized storage for count T, for trivially destructible types
+template<typename T>
+static T* FrameAllocArray(int count) {
+    return (T*)ImWidgets::FrameAlloc(sizeof(T) * (size_t)ImMax(count, 0), alignof(T));
+}
+
+void* ImWidgets::FrameAlloc(size_t size, size_t alignment) {
+    IM_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    return GetFrameArena().Alloc(size, alignment);
+}
+
+char* ImWidgets::FrameStrdup(const char* text, const char* text_end) {
+    const size_t length = text_end ? (size_t)(text_end - text) : strlen(text);
+    char* copy = (char*)FrameAlloc(length + 1, 1);
+    memcpy(copy, text, length);
+    copy[length] = 0;
+    return copy;
+}
+
+char* ImWidgets::FrameFormat(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list args_copy;
+    va_copy(args_copy, args);
+    const int length = ImMax(vsnprintf(nullptr, 0, fmt, args), 0);
+    va_end(args);
+    char* out = (char*)FrameAlloc((size_t)length + 1, 1);
+    vsnprintf(out, (size_t)length + 1, fmt, args_copy);
+    va_end(args_copy);
+    return out;
+}
+
+void ImWidgets::GetFrameArenaStats(ImFrameArenaStats* out_stats) {
+    const ImFrameArena& arena = GetFrameArena();
+    out_stats->Used = arena.Frames[arena.Index].Used;
+    out_stats->LastFrameUsed = arena.Frames[arena.Index ^ 1].Used;
+    out_stats->HighWater = ImMax(arena.HighWater, out_stats->Used);
+    out_stats->Capacity = 0;
+    out_stats->Blocks = 0;
+    for (const ImFrameArena::Frame& frame : arena.Frames) {
+        for (const ImFrameArena::Block& block : frame.Blocks)
+            out_stats->Capacity += block.Size;
+        out_stats->Blocks += frame.Blocks.Size;
+    }
+}
+
+/*
+    FORMATTING
+*/
+
+static const char GDigitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+static const double GPowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+static char* FormatLiteral(char* out, const char* s) {
+    const size_t n = strlen(s);
+    memcpy(out, s, n);
+    return out + n;
+}
+
+// Writes exactly 'digits' digits of v, zero-padded
+static char* FormatDigits(char* out, ImU64 v, int digits) {
+    char* p = out + digits;
+    while (p - out >= 2) {
+        p -= 2;
+        memcpy(p, GDigitPairs + (v % 100) * 2, 2);
+        v /= 100;
+    }
+    if (p > out)
+        *--p = (char)('0' + v % 10);
+    return out + digits;
+}
+
+char* ImWidgets::FormatUnsigned(char* out, ImU64 v) {
+    char tmp[20];
+    char* p = tmp + sizeof(tmp);
+    while (v >= 100) {
+        const unsigned r = (unsigned)(v % 100);
+        v /= 100;
+        p -= 2;
+        memcpy(p, GDigitPairs + r * 2, 2);
+    }
+    if (v >= 10) {
+        p -= 2;
+        memcpy(p, GDigitPairs + v * 2, 2);
+    } else {
+        *--p = (char)('0' + v);
+    }
+    const size_t n = (size_t)(tmp + sizeof(tmp) - p);
+    memcpy(out, p, n);
+    return out + n;
+}
+
+char* ImWidgets::FormatSigned(char* out, ImS64 v) {
+    if (v < 0) {
+        *out++ = '-';
+        return FormatUnsigned(out, (ImU64)0 - (ImU64)v);
+    }
+    return FormatUnsigned(out, (ImU64)v);
+}
+
+char* ImWidgets::FormatFixed(char* out, double v, int decimals) {
+    decimals = ImClamp(decimals, 0, 9);
+    const double magnitude = fabs(v);
+    const double scaled = magnitude * GPowersOf10[decimals];
+    if (!(scaled < 9007199254740992.0)) {
+        char tmp[64];
+        const int n = ImFormatString(tmp, sizeof(tmp), fabs(v) < 1e20 ? "%.*f" : "%.*e", decimals, v);
+        memcpy(out, tmp, (size_t)n);
+        return out + n;
+    }
+    // Round the exact product like printf does, half to even: the error of the scaling is recovered with an fma
+    ImU64 units = (ImU64)scaled;
+    const double rest = (scaled - (double)units) - 0.5 + fma(magnitude, GPowersOf10[decimals], -scaled);
+    if (rest > 0.0 || (rest == 0.0 && (units & 1)))
+        units++;
+    const ImU64 unit = (ImU64)GPowersOf10[decimals];
+    if (signbit(v))
+        *out++ = '-';
+    out = FormatUnsigned(out, units / unit);
+    if (decimals > 0) {
+        *out++ = '.';
+        out = FormatDigits(out, units % unit, decimals);
+    }
+    return out;
+}
+
+char* ImWidgets::FormatPercent(char* out, float fraction, int decimals) {
+    out = FormatFixed(out, fraction * 100.0f, decimals);
+    *out++ = '%';
+    return out;
+}
+
+void ImCompiledFormat::Compile(const char* format) {
+    Ops.resize(0);
+    Text.resize(0);
+    auto add_literal = [this](const char* begin, const char* end) {
+        if (Ops.Size > 0 && Ops.back().Kind == OpKind_Literal && Ops.back().End == Text.Size) {
+            Ops.back().End += (int)(end - begin);
+        } else {
+            Op op = { OpKind_Literal, 0, Text.Size, Text.Size + (int)(end - begin) };
+            Ops.push_back(op);
+        }
+        const int offset = Text.Size;
+        Text.resize(offset + (int)(end - begin));
+        memcpy(Text.Data + offset, begin, (size_t)(end - begin));
+    };
+    const char* p = format;
+    while (*p) {
+        if (*p != '%') {
+            const char* literal_end = strchr(p, '%');
+            if (!literal_end)
+                literal_end = p + strlen(p);
+            add_literal(p, literal_end);
+            p = literal_end;
+            continue;
+        }
+        if (p[1] == '%') {
+            add_literal(p, p + 1);
+            p += 2;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion
+        const char* spec = p++;
+        while (*p && strchr("-+ #0", *p))
+            p++;
+        while (*p >= '0' && *p <= '9')
+            p++;
+        const bool plain = p == spec + 1;
+        int precision = -1;
+        if (*p == '.') {
+            precision = 0;
+            for (p++; *p >= '0' && *p <= '9'; p++)
+                precision = precision * 10 + (*p - '0');
+        }
+        const char* precision_end = p;
+        while (*p && strchr("hlLqjzt", *p))
+            p++;
+        if (!*p)
+            break;
+        const char conversion = *p++;
+
+        Op op = { OpKind_Literal, 0, Text.Size, Text.Size };
+        if (plain && precision < 0 && (conversion == 'd' || conversion == 'i')) {
+            op.Kind = OpKind_Signed;
+        } else if (plain && precision < 0 && conversion == 'u') {
+            op.Kind = OpKind_Unsigned;
+        } else if (plain && precision <= 9 && conversion == 'f') {
+            op.Kind = OpKind_Fixed;
+            op.Precision = precision < 0 ? 6 : precision;
+        } else if (strchr("diouxXfFeEgGaA", conversion)) {
+            // Rebuilt without the length modifier, integers are passed as long long
+            const bool integer = strchr("diouxX", conversion) != nullptr;
+            op.Kind = integer ? OpKind_PrintfInteger : OpKind_PrintfDouble;
+            const int offset = Text.Size;
+            Text.resize(offset + (int)(precision_end - spec));
+            memcpy(Text.Data + offset, spec, (size_t)(precision_end - spec));
+            if (integer) {
+                Text.push_back('l');
+                Text.push_back('l');
+            }
+            Text.push_back(conversion);
+            Text.push_back(0);
+            op.End = Text.Size;
+        } else {
+            // Unsupported conversions (%s, %c, %p...) are kept as text
+            add_literal(spec, p);
+            continue;
+        }
+        Ops.push_back(op);
+    }
+}
+
+int ImCompiledFormat::Format(char* buf, int buf_size, const double* args, int args_count) const {
+    if (buf_size <= 0)
+        return 0;
+    char* out = buf;
+    char* out_end = buf + buf_size - 1;
+    int arg = 0;
+    for (const Op& op : Ops) {
+        const char* text = Text.Data + op.Begin;
+        int length = op.End - op.Begin;
+        char tmp[128];
+        if (op.Kind != OpKind_Literal) {
+            const double v = arg < args_count ? args[arg] : 0.0;
+            arg++;
+            // Integer conversions truncate, out of range values saturate
+            const ImS64 integer = v != v ? 0 : (ImS64)ImClamp(v, -9.2e18, 9.2e18);
+            switch (op.Kind) {
+                case OpKind_Signed:         length = (int)(ImWidgets::FormatSigned(tmp, integer) - tmp); break;
+                case OpKind_Unsigned:       length = (int)(ImWidgets::FormatUnsigned(tmp, (ImU64)integer) - tmp); break;
+                case OpKind_Fixed:          length = (int)(ImWidgets::FormatFixed(tmp, v, op.Precision) - tmp); break;
+                case OpKind_PrintfInteger:  length = ImFormatString(tmp, sizeof(tmp), text, (long long)integer); break;
+                default:                    length = ImFormatString(tmp, sizeof(tmp), text, v); break;
+            }
+            text = tmp;
+        }
+        length = ImMin(length, (int)(out_end - out));
+        memcpy(out, text, (size_t)length);
+        out += length;
+    }
+    *out = 0;
+    return (int)(out - buf);
+}
+
 bool ImWidgets::ToggleSwitch(const char* label, bool* v, ImToggleFlags flags) {
     ImGui::PushID(label);
 
-    ImWidgetsStyle& style = GetStyle();
+    const ImWidgetsStyle& style = GetContext().Style;
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
     bool changed = false;
 
@@ -141,7 +930,7 @@ bool ImWidgets::ToggleSwitch(const char* label, bool* v, ImToggleFlags flags) {
 
     ImVec2 p = ImGui::GetItemRectMin();
 
-    static std::unordered_map<ImGuiID, float> animStates;
+    std::unordered_map<ImGuiID, float>& animStates = GetStatePool<float>(ImWidgetsContextSlot_ToggleSwitch);
     ImGuiID id = ImGui::GetID("##toggle");
     float& t = animStates[id]; 
     float target = *v ? 1.0f : 0.0f;
@@ -149,13 +938,19 @@ bool ImWidgets::ToggleSwitch(const char* label, bool* v, ImToggleFlags flags) {
     if (!disabled) {
         if (animated)
             t += (target - t) * std::clamp(20.0f * ImGui::GetIO().DeltaTime, 0.0f, 1.0f);
-        else
-            t = target;        
+        // Settle exactly, the easing alone stops an ulp short and would keep blending colors
+        if (!animated || ImFabs(target - t) < 1e-3f)
+            t = target;
     }
 
-    ImU32 col_bg = ImGui::GetColorU32(disabled
-        ? style.ImToggleSwitchDisabledColor
-        : ImLerp(style.ImToggleSwitchOffColor, style.ImToggleSwitchOnColor, t));
+    // Colors are blended only while the knob moves, a settled switch uses the compiled ones
+    ImU32 col_bg;
+    if (disabled)
+        col_bg = GetColorU32(ImWidgetsCol_ToggleSwitchDisabled);
+    else if (t == 0.0f || t == 1.0f)
+        col_bg = GetColorU32(t == 0.0f ? ImWidgetsCol_ToggleSwitchOff : ImWidgetsCol_ToggleSwitchOn);
+    else
+        col_bg = ImGui::GetColorU32(ImLerp(style.ImToggleSwitchOffColor, style.ImToggleSwitchOnColor, t));
 
     draw_list->AddRectFilled(
         p,
@@ -168,7 +963,7 @@ bool ImWidgets::ToggleSwitch(const char* label, bool* v, ImToggleFlags flags) {
         ImVec2(p.x + style.ImToggleSwitchRadius + t * (style.ImToggleSwitchSize.x - 2*style.ImToggleSwitchRadius),
                p.y + style.ImToggleSwitchRadius),
         style.ImToggleSwitchRadius - 1.5f,
-        ImGui::GetColorU32(style.ImToggleSwitchKnobColor)
+        GetColorU32(ImWidgetsCol_ToggleSwitchKnob)
     );
 
     ImGui::PopID();
@@ -184,10 +979,133 @@ bool ImWidgets::ToggleSwitch(const char* label, bool* v, ImToggleFlags flags) {
     return changed;
 }
 
+// Positions come from the item size and spacing, so only items in view (plus the selected and focused ones, for
+// keyboard navigation) are submitted. Arrows, Home/End and PageUp/PageDown move the selection across culled items.
+static bool RadioButtonGroupVirtualized(int* current, const char* const items[], int items_count, ImRadioButtonGroupFlags flags) {
+    std::unordered_map<ImGuiID, int>& focusedItems = GetStatePool<int>(ImWidgetsContextSlot_RadioButtonGroup);
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems || items_count <= 0)
+        return false;
+
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImDrawList* draw_list = window->DrawList;
+    const bool horizontal = !(flags & ImRadioButtonGroupFlags_Vertical);
+    const bool disabled = (flags & ImRadioButtonGroupFlags_Disabled) != 0;
+    const int axis = horizontal ? 0 : 1;
+    const ImVec2 item_size = style.ImRadioButtonGroupSize;
+
+    // Same layout as the submitted path: SameLine() spacing horizontally, a Dummy() spacer with ItemSpacing on both sides vertically
+    const float step = ImMax(horizontal ? item_size.x + style.ImRadioButtonGroupSpacing : item_size.y + style.ImRadioButtonGroupSpacing + ImGui::GetStyle().ItemSpacing.y * 2.0f, 1.0f);
+    const ImVec2 origin = window->DC.CursorPos;
+    ImVec2 total_size = item_size;
+    total_size[axis] = step * (items_count - 1) + item_size[axis];
+    auto item_rect = [&](int i) {
+        ImVec2 min = origin;
+        min[axis] += step * i;
+        return ImRect(min, ImVec2(min.x + item_size.x, min.y + item_size.y));
+    };
+    auto item_id = [](int i) {
+        ImGui::PushID(i);
+        ImGuiID id = ImGui::GetID("##toggle");
+        ImGui::PopID();
+        return id;
+    };
+
+    int& focused = focusedItems.emplace(ImGui::GetID("##group"), -1).first->second;
+    if (focused >= items_count)
+        focused = -1;
+    int moved_to = -1;
+    if (focused >= 0 && !disabled) {
+        const ImGuiKey prev_key = horizontal ? ImGuiKey_LeftArrow : ImGuiKey_UpArrow;
+        const ImGuiKey next_key = horizontal ? ImGuiKey_RightArrow : ImGuiKey_DownArrow;
+        const int page = ImMax((int)(window->ClipRect.GetSize()[axis] / step), 1);
+        int target = focused;
+        if (ImGui::IsKeyPressed(prev_key))                target--;
+        if (ImGui::IsKeyPressed(next_key))                target++;
+        if (ImGui::IsKeyPressed(ImGuiKey_PageUp))         target -= page;
+        if (ImGui::IsKeyPressed(ImGuiKey_PageDown))       target += page;
+        if (ImGui::IsKeyPressed(ImGuiKey_Home))           target = 0;
+        if (ImGui::IsKeyPressed(ImGuiKey_End))            target = items_count - 1;
+        target = ImClamp(target, 0, items_count - 1);
+        if (target != focused)
+            moved_to = target;
+        // Keep navigation from moving focus on its own, it can't see culled items
+        const ImGuiID focused_id = item_id(focused);
+        for (ImGuiKey key : { prev_key, next_key, ImGuiKey_PageUp, ImGuiKey_PageDown, ImGuiKey_Home, ImGuiKey_End })
+            ImGui::SetKeyOwner(key, focused_id);
+    }
+
+    const float clip_min = window->ClipRect.Min[axis] - origin[axis];
+    const float clip_max = window->ClipRect.Max[axis] - origin[axis];
+    const int first = ImClamp((int)floorf(clip_min / step), 0, items_count);
+    const int last = ImClamp((int)ceilf(clip_max / step) + 1, first, items_count);
+
+    bool changed = false;
+    int new_focused = -1;
+    auto submit = [&](int i) {
+        const ImGuiID id = item_id(i);
+        const ImRect bb = item_rect(i);
+        if (i == moved_to) {
+            ImGui::SetFocusID(id, window);
+            ImGui::ScrollToRect(window, bb);
+            ImGui::SetNavCursorVisibleAfterMove();
+            if (*current != i) {
+                *current = i;
+                changed = true;
+            }
+        }
+        const bool visible = ImGui::ItemAdd(bb, id);
+        if (ImGui::GetFocusID() == id)
+            new_focused = i;
+        if (!visible)
+            return;
+        bool hovered, held;
+        if (ImGui::ButtonBehavior(bb, id, &hovered, &held) && !disabled && *current != i) {
+            *current = i;
+            changed = true;
+        }
+
+        const ImU32 bg_color = ImWidgets::GetColorU32(disabled ? ImWidgetsCol_RadioButtonGroupDisabled : (*current == i ? ImWidgetsCol_RadioButtonGroupActive : ImWidgetsCol_RadioButtonGroupInactive));
+        const ImU32 text_color = ImWidgets::GetColorU32(disabled ? ImWidgetsCol_RadioButtonGroupDisabledText : (*current == i ? ImWidgetsCol_RadioButtonGroupActiveText : ImWidgetsCol_RadioButtonGroupInactiveText));
+        draw_list->AddRectFilled(bb.Min, bb.Max, bg_color, 5.0f);
+        ImGui::RenderNavCursor(bb, id);
+
+        const float max_width = item_size.x - 2.0f;
+        const ImVec2 text_size = ImGui::CalcTextSize(items[i]);
+        const float text_y = bb.Min.y + (item_size.y - text_size.y) * 0.5f;
+        if (text_size.x <= max_width)
+            draw_list->AddText(ImVec2(bb.Min.x + (item_size.x - text_size.x) * 0.5f, text_y), text_color, items[i]);
+        else
+            DrawTextWithEllipsis(draw_list, ImVec2(bb.Min.x + 1.0f, text_y), text_color, items[i], nullptr, max_width, text_size.x);
+    };
+    for (int i = first; i < last; i++)
+        submit(i);
+    const int extra[] = { *current, focused, moved_to };
+    for (int e = 0; e < IM_ARRAYSIZE(extra); e++) {
+        const int i = extra[e];
+        bool duplicate = i < 0 || i >= items_count || (i >= first && i < last);
+        for (int k = 0; k < e && !duplicate; k++)
+            duplicate = extra[k] == i;
+        if (!duplicate)
+            submit(i);
+    }
+    focused = new_focused;
+
+    const ImRect total(origin, ImVec2(origin.x + total_size.x, origin.y + total_size.y));
+    ImGui::ItemSize(total_size);
+    ImGui::ItemAdd(total, 0);
+    return changed;
+}
+
 bool ImWidgets::RadioButtonGroup(const char* label, int* current, const char* const items[], int items_count, ImRadioButtonGroupFlags flags) {
     ImGui::PushID(label);
+    if (flags & ImRadioButtonGroupFlags_Virtualized) {
+        bool changed = RadioButtonGroupVirtualized(current, items, items_count, flags);
+        ImGui::PopID();
+        return changed;
+    }
 
-    ImWidgetsStyle& style = GetStyle();
+    const ImWidgetsStyle& style = GetContext().Style;
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
     bool changed = false;
 
@@ -206,42 +1124,42 @@ bool ImWidgets::RadioButtonGroup(const char* label, int* current, const char* co
         ImVec2 p_max = ImGui::GetItemRectMax();
         ImVec2 rect_size = ImVec2(p_max.x - p_min.x, p_max.y - p_min.y);
 
-        ImVec4 bg_color;
+        ImWidgetsCol bg_color;
         if (disabled) {
-            bg_color = style.ImRadioButtonGroupDisabledColor;
+            bg_color = ImWidgetsCol_RadioButtonGroupDisabled;
         } else if (*current == i) {
-            bg_color = style.ImRadioButtonGroupActiveColor;
+            bg_color = ImWidgetsCol_RadioButtonGroupActive;
         } else {
-            bg_color = style.ImRadioButtonGroupInactiveColor;
+            bg_color = ImWidgetsCol_RadioButtonGroupInactive;
         }
 
         draw_list->AddRectFilled(
             p_min,
             p_max,
-            ImGui::GetColorU32(bg_color),
+            GetColorU32(bg_color),
             5.0f
         );
 
-        std::string trimmed_text = TrimTextWithEllipsis(items[i], rect_size.x - 2.0f);
-        ImVec2 text_size = ImGui::CalcTextSize(trimmed_text.c_str());
+        const char* trimmed_text = TrimTextWithEllipsis(items[i], rect_size.x - 2.0f);
+        ImVec2 text_size = ImGui::CalcTextSize(trimmed_text);
         ImVec2 text_pos = ImVec2(
             p_min.x + (rect_size.x - text_size.x) * 0.5f,
             p_min.y + (rect_size.y - text_size.y) * 0.5f
         );
 
-        ImVec4 text_color;
+        ImWidgetsCol text_color;
         if (disabled) {
-            text_color = style.ImRadioButtonGroupDisabledTextColor;
+            text_color = ImWidgetsCol_RadioButtonGroupDisabledText;
         } else if (*current == i) {
-            text_color = style.ImRadioButtonGroupActiveTextColor;
+            text_color = ImWidgetsCol_RadioButtonGroupActiveText;
         } else {
-            text_color = style.ImRadioButtonGroupInactiveTextColor;
+            text_color = ImWidgetsCol_RadioButtonGroupInactiveText;
         }
 
         draw_list->AddText(
             text_pos, 
-            ImGui::GetColorU32(text_color), 
-            trimmed_text.c_str()
+            GetColorU32(text_color), 
+            trimmed_text
         );
 
         ImGui::PopID();
@@ -258,9 +1176,59 @@ bool ImWidgets::RadioButtonGroup(const char* label, int* current, const char* co
     return changed;
 }
 
+// Last label of each progress bar, formatted again only when what it shows changes
+struct ImProgressBarLabel {
+    float   Min = 0.0f;
+    float   Max = 0.0f;
+    float   Current = 0.0f;
+    bool    HasFormat = false;
+    std::string Format;
+    int     Flags = -1;
+    char    Text[64] = {};
+};
+
+// Compiled ProgressBar formats by text. Formats built per frame would pile up: past MaxEntries the least recently
+// used one is compiled over
+struct ImProgressBarFormats {
+    static const int MaxEntries = 32;
+
+    struct Entry {
+        std::string         Text;
+        ImCompiledFormat    Compiled;
+        int                 LastUse = 0;
+    };
+    std::vector<Entry>  Entries;
+    int                 Tick = 0;
+
+    const ImCompiledFormat& Get(const char* format) {
+        Entry* entry = nullptr;
+        for (Entry& e : Entries)
+            if (e.Text == format) {
+                entry = &e;
+                break;
+            }
+        if (!entry) {
+            if ((int)Entries.size() < MaxEntries) {
+                Entries.emplace_back();
+                entry = &Entries.back();
+            } else {
+                entry = &*std::min_element(Entries.begin(), Entries.end(), [](const Entry& a, const Entry& b) { return a.LastUse < b.LastUse; });
+            }
+            entry->Text = format;
+            entry->Compiled.Compile(format);
+        }
+        entry->LastUse = ++Tick;
+        return entry->Compiled;
+    }
+};
+
 void ImWidgets::ProgressBar(const char* label, float min, float max, float current, ImToggleFlags flags) {
+    ProgressBar(label, min, max, current, nullptr, flags);
+}
+
+void ImWidgets::ProgressBar(const char* label, float min, float max, float current, const char* format, ImToggleFlags flags) {
     ImGui::PushID(label);
-    ImWidgetsStyle& style = GetStyle();
+    const ImWidgetsStyle& style = GetContext().Style;
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
     if ((flags & ImProgressBarFLags_NoLabel) && (flags & ImProgressBarFlags_PercentageLabel)) {
@@ -274,12 +1242,31 @@ void ImWidgets::ProgressBar(const char* label, float min, float max, float curre
         progress = std::clamp(progress, 0.0f, 1.0f);
     }
 
-    char label_buf[64];
+    const char* label_buf = "";
     if (!(flags & ImProgressBarFLags_NoLabel)) {
-        if (flags & ImProgressBarFlags_PercentageLabel)
-            snprintf(label_buf, sizeof(label_buf), "%.0f%%", progress * 100.0f);
-        else
-            snprintf(label_buf, sizeof(label_buf), "%f / %f", current, max);
+        std::unordered_map<ImGuiID, ImProgressBarLabel>& labels = GetStatePool<ImProgressBarLabel>(ImWidgetsContextSlot_ProgressBarLabels);
+        ImProgressBarLabel& memo = labels[ImGui::GetID("##label")];
+        const bool format_changed = format ? !memo.HasFormat || memo.Format != format : memo.HasFormat;
+        if (memo.Min != min || memo.Max != max || memo.Current != current || format_changed || memo.Flags != flags) {
+            memo.Min = min;
+            memo.Max = max;
+            memo.Current = current;
+            memo.HasFormat = format != nullptr;
+            memo.Format = format ? format : "";
+            memo.Flags = flags;
+            if (format) {
+                const ImCompiledFormat& compiled = GetContextValue<ImProgressBarFormats>(ImWidgetsContextSlot_ProgressBarFormats).Get(format);
+                const double args[] = { current, max, progress * 100.0f };
+                compiled.Format(memo.Text, sizeof(memo.Text), args, IM_ARRAYSIZE(args));
+            } else if (flags & ImProgressBarFlags_PercentageLabel) {
+                *FormatPercent(memo.Text, progress) = 0;
+            } else {
+                char* p = FormatFixed(memo.Text, current, 6);
+                p = FormatLiteral(p, " / ");
+                *FormatFixed(p, max, 6) = 0;
+            }
+        }
+        label_buf = memo.Text;
     }
 
     ImVec2 pos = ImGui::GetCursorScreenPos();
@@ -293,17 +1280,17 @@ void ImWidgets::ProgressBar(const char* label, float min, float max, float curre
         // Background circle
         draw_list->PathClear();
         draw_list->PathArcTo(center, style.ImProgressBarCircleRadius, 0, IM_PI * 2, 64);
-        draw_list->PathStroke(ImGui::GetColorU32(style.ImProgressBarBgColor), false, style.ImProgressBarCircleThickness);
+        draw_list->PathStroke(GetColorU32(ImWidgetsCol_ProgressBarBg), false, style.ImProgressBarCircleThickness);
 
         // Progress arc
         float start_angle = -IM_PI * 0.5f;
         float end_angle = start_angle + (IM_PI * 2.0f) * progress;
         draw_list->PathClear();
         draw_list->PathArcTo(center, style.ImProgressBarCircleRadius, start_angle, end_angle, 64);
-        draw_list->PathStroke(ImGui::GetColorU32(style.ImProgressBarColor), false, style.ImProgressBarCircleThickness);
+        draw_list->PathStroke(GetColorU32(ImWidgetsCol_ProgressBar), false, style.ImProgressBarCircleThickness);
 
         if (!(flags & ImProgressBarFLags_NoLabel))
-            DrawCenteredText(draw_list, center, label_buf, ImGui::GetColorU32(style.ImProgressBarTextColor));
+            DrawCenteredText(draw_list, center, label_buf, GetColorU32(ImWidgetsCol_ProgressBarText));
 
         ImVec2 bounds(style.ImProgressBarRadius * 2, style.ImProgressBarRadius * 2);
         ImGui::Dummy(bounds);
@@ -316,17 +1303,17 @@ void ImWidgets::ProgressBar(const char* label, float min, float max, float curre
         ImVec2 p_min = pos;
         ImVec2 p_max(pos.x + size.x, pos.y + size.y);
 
-        draw_list->AddRectFilled(p_min, p_max, ImGui::GetColorU32(style.ImProgressBarBgColor), 5.0f);
+        draw_list->AddRectFilled(p_min, p_max, GetColorU32(ImWidgetsCol_ProgressBarBg), 5.0f);
         draw_list->AddRectFilled(
             p_min,
             ImVec2(p_min.x + size.x * progress, p_max.y),
-            ImGui::GetColorU32(style.ImProgressBarColor),
+            GetColorU32(ImWidgetsCol_ProgressBar),
             5.0f
         );
 
         if (!(flags & ImProgressBarFLags_NoLabel)) {
             ImVec2 center(p_min.x + size.x * 0.5f, p_min.y + size.y * 0.5f);
-            DrawCenteredText(draw_list, center, label_buf, ImGui::GetColorU32(style.ImProgressBarTextColor));
+            DrawCenteredText(draw_list, center, label_buf, GetColorU32(ImWidgetsCol_ProgressBarText));
         }
 
         ImGui::Dummy(size);
@@ -338,7 +1325,7 @@ void ImWidgets::ProgressBar(const char* label, float min, float max, float curre
 void ImWidgets::Spinner(const char* label, ImSpinnerFlags flags) {
     ImGui::PushID(label);
 
-    ImWidgetsStyle& style = GetStyle();
+    const ImWidgetsStyle& style = GetContext().Style;
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
     float time = static_cast<float>(ImGui::GetTime());
@@ -367,7 +1354,7 @@ void ImWidgets::Spinner(const char* label, ImSpinnerFlags flags) {
 
     draw_list->PathClear();
     draw_list->PathArcTo(center, style.ImSpinnerRadius, rotation, rotation + arc_angle, style.ImSpinnerSegments);
-    draw_list->PathStroke(ImGui::GetColorU32(style.ImSpinnerColor), false, style.ImSpinnerThickness);
+    draw_list->PathStroke(GetColorU32(ImWidgetsCol_Spinner), false, style.ImSpinnerThickness);
 
     ImGui::Dummy(spinner_size);
 
@@ -379,18 +1366,36 @@ void ImWidgets::Spinner(const char* label, ImSpinnerFlags flags) {
     ImGui::PopID();
 }
 
+// Month shown and day highlighted, starting at today
+struct ImCalendarState {
+    int     Year = -1;
+    int     Month = 0;
+    int     Day = 0;
+};
+
 void ImWidgets::Calendar(const char* label, int& day, int& month, int& year, ImCalendarFlags flags)
 {
     ImGui::PushID(label);
 
-    ImWidgetsStyle& style = GetStyle();
+    const ImWidgetsStyle& style = GetContext().Style;
 
-    time_t t = time(nullptr);
-    const tm* now = localtime(&t);
-
-    static int year_ = now->tm_year + 1900;
-    static int month_ = now->tm_mon;
-    static int day_ = now->tm_mday;
+    ImCalendarState& st = GetStatePool<ImCalendarState>(ImWidgetsContextSlot_Calendar)[ImGui::GetID("##calendar")];
+    if (st.Year < 0) {
+        // localtime() shares its result between threads
+        const time_t t = time(nullptr);
+        tm now;
+#ifdef _WIN32
+        localtime_s(&now, &t);
+#else
+        localtime_r(&t, &now);
+#endif
+        st.Year = now.tm_year + 1900;
+        st.Month = now.tm_mon;
+        st.Day = now.tm_mday;
+    }
+    int& year_ = st.Year;
+    int& month_ = st.Month;
+    int& day_ = st.Day;
 
     auto normalize_month = [&]() {
         if (month_ > 11) {
@@ -496,4 +1501,5824 @@ void ImWidgets::TabStrip(const char* label, ImGuiTabBarFlags flags) {
 void ImWidgets::Tab(const char* label, bool* p_open) {
     
     ImGui::PushID(label);
-}
\ No newline at end of file
+}
+/*
+    RICH TEXT
+*/
+
+enum ImRichTextStyle_ {
+    ImRichTextStyle_Bold    = 1 << 0,
+    ImRichTextStyle_Italic  = 1 << 1,
+    ImRichTextStyle_Color   = 1 << 2,
+    ImRichTextStyle_Link    = 1 << 3,
+};
+
+struct ImRichTextAttr {
+    ImU32   Color;
+    float   Scale;
+    int     Style;
+    int     Link;       // Offset into ImRichTextState::Links, -1 if none
+};
+
+// A span of the stripped text sharing the same attributes
+struct ImRichTextRun {
+    int             TextBegin, TextEnd;
+    ImRichTextAttr  Attr;
+};
+
+// The part of a run that lands on a single line
+struct ImRichTextFragment {
+    int     Run;
+    int     TextBegin, TextEnd;
+    float   X, Width;
+};
+
+struct ImRichTextLine {
+    int     TextBegin;
+    int     FragmentBegin, FragmentEnd;
+    float   Y, Height, Width;
+};
+
+struct ImRichTextState {
+    // Parse cache, keyed by the hash of the source text, which is only checked when the buffer or version changed
+    ImGuiID                     SourceHash = 0;
+    int                         SourceLen = -1;
+    const char*                 SourcePtr = nullptr;
+    int                         SourceVersion = 0;
+    ImVector<char>              Text;
+    ImVector<char>              Links;
+    ImVector<ImRichTextRun>     Runs;
+
+    // Start of the last paragraph, parsing resumes from here when text is appended
+    int                         ResumeSource = 0;
+    int                         ResumeText = 0;
+    int                         ResumeRuns = 0;
+    int                         ResumeLinks = 0;
+    ImVector<ImRichTextAttr>    ResumeStack;
+
+    // Layout cache, keyed by (font, font size, wrap width)
+    ImFont*                     LayoutFont = nullptr;
+    float                       LayoutFontSize = 0.0f;
+    float                       LayoutWrapWidth = -1.0f;
+    ImVector<ImRichTextFragment> Fragments;
+    ImVector<ImRichTextLine>    Lines;
+    float                       Width = 0.0f;
+    float                       Height = 0.0f;
+};
+
+static bool RichTextParseHexColor(const char* s, const char* s_end, ImU32* out) {
+    int len = (int)(s_end - s);
+    if (len != 6 && len != 8)
+        return false;
+    ImU32 v = 0;
+    for (const char* p = s; p < s_end; p++) {
+        int d;
+        if (*p >= '0' && *p <= '9')      d = *p - '0';
+        else if (*p >= 'a' && *p <= 'f') d = *p - 'a' + 10;
+        else if (*p >= 'A' && *p <= 'F') d = *p - 'A' + 10;
+        else return false;
+        v = (v << 4) | (ImU32)d;
+    }
+    if (len == 6)
+        v = (v << 8) | 0xFF;
+    *out = IM_COL32((v >> 24) & 0xFF, (v >> 16) & 0xFF, (v >> 8) & 0xFF, v & 0xFF);
+    return true;
+}
+
+// Parses src[src_begin, src_end) into st.Text/Runs/Links, continuing from the attribute stack in st.ResumeStack
+static void RichTextParse(ImRichTextState& st, const char* src, int src_begin, int src_end) {
+    ImVector<ImRichTextAttr> stack = st.ResumeStack;
+    if (stack.Size == 0)
+        stack.push_back({ 0, 1.0f, 0, -1 });
+
+    int run_begin = st.Text.Size;
+    auto flush_run = [&]() {
+        if (st.Text.Size > run_begin)
+            st.Runs.push_back({ run_begin, st.Text.Size, stack.back() });
+        run_begin = st.Text.Size;
+    };
+
+    const char* p = src + src_begin;
+    const char* p_end = src + src_end;
+    while (p < p_end) {
+        if (*p == '[') {
+            if (p + 1 < p_end && p[1] == '[') {
+                st.Text.push_back('[');
+                p += 2;
+                continue;
+            }
+            const char* tag_end = (const char*)memchr(p, ']', (size_t)ImMin(p_end - p, (ptrdiff_t)256));
+            if (tag_end) {
+                const char* name = p + 1;
+                const char* value = (const char*)memchr(name, '=', (size_t)(tag_end - name));
+                const char* name_end = value ? value : tag_end;
+                if (value)
+                    value++;
+                auto is = [&](const char* tag) { return (int)strlen(tag) == (int)(name_end - name) && memcmp(name, tag, name_end - name) == 0; };
+
+                ImRichTextAttr attr = stack.back();
+                bool push = false, pop = false;
+                if (is("b"))            { attr.Style |= ImRichTextStyle_Bold; push = true; }
+                else if (is("i"))       { attr.Style |= ImRichTextStyle_Italic; push = true; }
+                else if (is("color") && value && RichTextParseHexColor(value, tag_end, &attr.Color)) { attr.Style |= ImRichTextStyle_Color; push = true; }
+                else if (is("size") && value) { attr.Scale = ImClamp((float)atof(value), 0.25f, 8.0f); push = true; }
+                else if (is("url") && value) {
+                    attr.Style |= ImRichTextStyle_Link;
+                    attr.Link = st.Links.Size;
+                    for (const char* v = value; v < tag_end; v++)
+                        st.Links.push_back(*v);
+                    st.Links.push_back(0);
+                    push = true;
+                }
+                else if (is("/b") || is("/i") || is("/color") || is("/size") || is("/url")) { pop = true; }
+
+                if (push || pop) {
+                    flush_run();
+                    if (push)
+                        stack.push_back(attr);
+                    else if (stack.Size > 1)
+                        stack.pop_back();
+                    p = tag_end + 1;
+                    continue;
+                }
+            }
+        }
+
+        st.Text.push_back(*p++);
+        if (p[-1] == '\n') {
+            flush_run();
+            st.ResumeSource = (int)(p - src);
+            st.ResumeText = st.Text.Size;
+            st.ResumeRuns = st.Runs.Size;
+            st.ResumeLinks = st.Links.Size;
+            st.ResumeStack = stack;
+        }
+    }
+    flush_run();
+}
+
+// Lays out runs [first_run, end) starting on a fresh line below the lines already in st.Lines
+static void RichTextLayout(ImRichTextState& st, int first_run, float wrap_width) {
+    ImFont* font = st.LayoutFont;
+    const char* text = st.Text.Data;
+    float x = 0.0f;
+    float y = st.Height;
+
+    struct { int Run, Pos, Fragment; float X; } brk = { 0, 0, -1, 0.0f };
+    auto begin_line = [&](int pos) {
+        st.Lines.push_back({ pos, st.Fragments.Size, st.Fragments.Size, y, 0.0f, 0.0f });
+        x = 0.0f;
+        brk.Fragment = -1;
+    };
+    auto end_line = [&](int run) {
+        ImRichTextLine& line = st.Lines.back();
+        line.FragmentEnd = st.Fragments.Size;
+        for (int i = line.FragmentBegin; i < line.FragmentEnd; i++) {
+            const ImRichTextFragment& f = st.Fragments[i];
+            line.Height = ImMax(line.Height, st.LayoutFontSize * st.Runs[f.Run].Attr.Scale);
+            line.Width = ImMax(line.Width, f.X + f.Width);
+        }
+        if (line.Height == 0.0f)
+            line.Height = st.LayoutFontSize * (st.Runs.Size ? st.Runs[ImMin(run, st.Runs.Size - 1)].Attr.Scale : 1.0f);
+        y += line.Height;
+        st.Width = ImMax(st.Width, line.Width);
+    };
+
+    int r = first_run;
+    int p = r < st.Runs.Size ? st.Runs[r].TextBegin : st.Text.Size;
+    int baked_run = -1;
+    ImFontBaked* baked = nullptr;
+    float scale = 1.0f;
+    bool need_fragment = true;
+    bool skip_spaces = false;
+
+    begin_line(p);
+    while (r < st.Runs.Size) {
+        const ImRichTextRun& run = st.Runs[r];
+        if (p >= run.TextEnd) {
+            if (++r < st.Runs.Size)
+                p = st.Runs[r].TextBegin;
+            need_fragment = true;
+            continue;
+        }
+        if (baked_run != r) {
+            float size = st.LayoutFontSize * run.Attr.Scale;
+            baked = font->GetFontBaked(size);
+            scale = size / baked->Size;
+            baked_run = r;
+        }
+
+        unsigned int c = 0;
+        int n = ImTextCharFromUtf8(&c, text + p, text + run.TextEnd);
+        if (c == '\n') {
+            end_line(r);
+            p += n;
+            begin_line(p);
+            need_fragment = true;
+            skip_spaces = false;
+            continue;
+        }
+        if (skip_spaces && c == ' ') {
+            p += n;
+            need_fragment = true;
+            continue;
+        }
+        skip_spaces = false;
+
+        float advance = baked->GetCharAdvance((ImWchar)c) * scale;
+        if (wrap_width > 0.0f && x + advance > wrap_width && x > 0.0f) {
+            // Break at the last space of this line, or right here if the word is wider than the line
+            if (c != ' ' && brk.Fragment >= st.Lines.back().FragmentBegin) {
+                st.Fragments.resize(brk.Fragment + 1);
+                ImRichTextFragment& f = st.Fragments.back();
+                f.TextEnd = brk.Pos;
+                f.Width = brk.X - f.X;
+                r = brk.Run;
+                p = brk.Pos;
+            }
+            end_line(r);
+            begin_line(p);
+            need_fragment = true;
+            skip_spaces = true;
+            continue;
+        }
+
+        if (need_fragment) {
+            st.Fragments.push_back({ r, p, p, x, 0.0f });
+            need_fragment = false;
+        }
+        ImRichTextFragment& f = st.Fragments.back();
+        p += n;
+        x += advance;
+        f.TextEnd = p;
+        f.Width += advance;
+        if (c == ' ')
+            brk = { r, p, st.Fragments.Size - 1, x };
+    }
+    end_line(r);
+    st.Height = y;
+}
+
+bool ImWidgets::RichText(const char* label, const char* text, const char* text_end, const char** out_link, ImRichTextFlags flags, int text_version) {
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImGuiID id = window->GetID(label);
+
+    std::unordered_map<ImGuiID, ImRichTextState>& richTextStates = GetStatePool<ImRichTextState>(ImWidgetsContextSlot_RichText);
+    ImRichTextState& st = richTextStates[id];
+
+    if (!text_end)
+        text_end = text + strlen(text);
+    int len = (int)(text_end - text);
+
+    // Parse: reuse everything when the text is unchanged, re-parse only the last paragraph when text was appended.
+    // The same buffer and version is trusted to hold the same prefix, anything else is checked against its hash
+    int relayout_text = -1, relayout_run = 0;
+    const bool same_buffer = text == st.SourcePtr && text_version == st.SourceVersion;
+    st.SourcePtr = text;
+    st.SourceVersion = text_version;
+    if (st.SourceLen >= 0 && len >= st.SourceLen && (same_buffer || ImHashData(text, st.SourceLen) == st.SourceHash)) {
+        if (len > st.SourceLen) {
+            relayout_text = st.ResumeText;
+            relayout_run = st.ResumeRuns;
+            st.Text.resize(st.ResumeText);
+            st.Runs.resize(st.ResumeRuns);
+            st.Links.resize(st.ResumeLinks);
+            st.SourceHash = ImHashData(text + st.SourceLen, len - st.SourceLen, st.SourceHash);
+            st.SourceLen = len;
+            RichTextParse(st, text, st.ResumeSource, len);
+        }
+    } else {
+        st.Text.resize(0);
+        st.Runs.resize(0);
+        st.Links.resize(0);
+        st.ResumeSource = st.ResumeText = st.ResumeRuns = st.ResumeLinks = 0;
+        st.ResumeStack.resize(0);
+        st.SourceHash = ImHashData(text, len);
+        st.SourceLen = len;
+        st.LayoutWrapWidth = -1.0f;
+        RichTextParse(st, text, 0, len);
+    }
+
+    // Layout: full when the font or width changed, from the re-parsed paragraph when text was appended
+    ImFont* font = ImGui::GetFont();
+    float font_size = ImGui::GetFontSize();
+    float wrap_width = (flags & ImRichTextFlags_NoWrap) ? 0.0f : ImMax(ImGui::GetContentRegionAvail().x, 1.0f);
+    int relayout_line = 0;
+    if (relayout_text >= 0)
+        while (relayout_line < st.Lines.Size && st.Lines[relayout_line].TextBegin < relayout_text)
+            relayout_line++;
+
+    if (st.LayoutFont != font || st.LayoutFontSize != font_size || st.LayoutWrapWidth != wrap_width || relayout_line == st.Lines.Size) {
+        st.LayoutFont = font;
+        st.LayoutFontSize = font_size;
+        st.LayoutWrapWidth = wrap_width;
+        st.Fragments.resize(0);
+        st.Lines.resize(0);
+        st.Width = st.Height = 0.0f;
+        RichTextLayout(st, 0, wrap_width);
+    } else if (relayout_text >= 0) {
+        st.Fragments.resize(st.Lines[relayout_line].FragmentBegin);
+        st.Height = st.Lines[relayout_line].Y;
+        st.Lines.resize(relayout_line);
+        st.Width = 0.0f;
+        for (const ImRichTextLine& l : st.Lines)
+            st.Width = ImMax(st.Width, l.Width);
+        RichTextLayout(st, relayout_run, wrap_width);
+    }
+
+    ImVec2 pos = window->DC.CursorPos;
+    ImVec2 size(wrap_width > 0.0f ? wrap_width : st.Width, st.Height);
+    ImRect bb(pos, ImVec2(pos.x + size.x, pos.y + size.y));
+    ImGui::ItemSize(size);
+    if (!ImGui::ItemAdd(bb, id))
+        return false;
+
+    // Visible lines only
+    float clip_min = window->ClipRect.Min.y - pos.y;
+    float clip_max = window->ClipRect.Max.y - pos.y;
+    const ImRichTextLine* line_begin = std::upper_bound(st.Lines.begin(), st.Lines.end(), clip_min,
+        [](float v, const ImRichTextLine& l) { return v < l.Y + l.Height; });
+    const ImRichTextLine* line_end = line_begin;
+    while (line_end < st.Lines.end() && line_end->Y < clip_max)
+        line_end++;
+
+    int hovered_link = -1;
+    if (ImGui::IsItemHovered()) {
+        ImVec2 mouse = ImGui::GetIO().MousePos;
+        for (const ImRichTextLine* line = line_begin; line < line_end && hovered_link < 0; line++) {
+            if (mouse.y < pos.y + line->Y || mouse.y >= pos.y + line->Y + line->Height)
+                continue;
+            for (int i = line->FragmentBegin; i < line->FragmentEnd; i++) {
+                const ImRichTextFragment& f = st.Fragments[i];
+                if (mouse.x >= pos.x + f.X && mouse.x < pos.x + f.X + f.Width) {
+                    hovered_link = st.Runs[f.Run].Attr.Link;
+                    break;
+                }
+            }
+        }
+    }
+
+    bool clicked = false;
+    if (hovered_link >= 0) {
+        ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
+        if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+            clicked = true;
+            if (out_link)
+                *out_link = st.Links.Data + hovered_link;
+        }
+    }
+
+    ImDrawList* draw_list = window->DrawList;
+    ImU32 col_text = ImGui::GetColorU32(ImGuiCol_Text);
+    ImU32 col_link = GetColorU32(ImWidgetsCol_RichTextLink);
+    ImU32 col_link_hovered = GetColorU32(ImWidgetsCol_RichTextLinkHovered);
+    for (const ImRichTextLine* line = line_begin; line < line_end; line++) {
+        for (int i = line->FragmentBegin; i < line->FragmentEnd; i++) {
+            const ImRichTextFragment& f = st.Fragments[i];
+            const ImRichTextAttr& attr = st.Runs[f.Run].Attr;
+            float frag_size = font_size * attr.Scale;
+            ImVec2 frag_pos(pos.x + f.X, pos.y + line->Y + line->Height - frag_size);
+            const char* s = st.Text.Data + f.TextBegin;
+            const char* s_end = st.Text.Data + f.TextEnd;
+
+            ImU32 col = col_text;
+            if (attr.Style & ImRichTextStyle_Link)
+                col = (attr.Link == hovered_link) ? col_link_hovered : col_link;
+            else if (attr.Style & ImRichTextStyle_Color)
+                col = attr.Color;
+
+            int vtx_begin = draw_list->VtxBuffer.Size;
+            draw_list->AddText(font, frag_size, frag_pos, col, s, s_end);
+            if (attr.Style & ImRichTextStyle_Bold)
+                draw_list->AddText(font, frag_size, ImVec2(frag_pos.x + 1.0f, frag_pos.y), col, s, s_end);
+            if (attr.Style & ImRichTextStyle_Italic) {
+                float baseline = frag_pos.y + frag_size;
+                for (int v = vtx_begin; v < draw_list->VtxBuffer.Size; v++)
+                    draw_list->VtxBuffer[v].pos.x += (baseline - draw_list->VtxBuffer[v].pos.y) * style.ImRichTextItalicShear;
+            }
+            if (attr.Style & ImRichTextStyle_Link)
+                draw_list->AddLine(ImVec2(frag_pos.x, frag_pos.y + frag_size), ImVec2(frag_pos.x + f.Width, frag_pos.y + frag_size), col);
+        }
+    }
+
+    return clicked;
+}
+
+/*
+    FILE MAPPING
+*/
+
+// Handle for positioned reads. Unlike a mapping, reading past the end of a file that shrank (truncated in place,
+// rotated with copytruncate) returns fewer bytes instead of raising SIGBUS, so files that others write are read this way.
+struct ImFile {
+#ifdef _WIN32
+    HANDLE      Handle = INVALID_HANDLE_VALUE;
+#else
+    int         Fd = -1;
+#endif
+
+    ImFile() = default;
+    ImFile(const ImFile&) = delete;
+    ImFile& operator=(const ImFile&) = delete;
+    ~ImFile() { Close(); }
+
+    bool IsOpen() const {
+#ifdef _WIN32
+        return Handle != INVALID_HANDLE_VALUE;
+#else
+        return Fd >= 0;
+#endif
+    }
+
+    // Writable opens create the file, or truncate it
+    bool Open(const char* path, bool writable = false) {
+        Close();
+#ifdef _WIN32
+        if (writable)
+            Handle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        else
+            Handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+        Fd = writable ? open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) : open(path, O_RDONLY | O_CLOEXEC);
+#endif
+        return IsOpen();
+    }
+
+    void Close() {
+#ifdef _WIN32
+        if (Handle != INVALID_HANDLE_VALUE)
+            CloseHandle(Handle);
+        Handle = INVALID_HANDLE_VALUE;
+#else
+        if (Fd >= 0)
+            close(Fd);
+        Fd = -1;
+#endif
+    }
+
+    ImU64 QueryFileSize() const {
+#ifdef _WIN32
+        LARGE_INTEGER size;
+        return GetFileSizeEx(Handle, &size) ? (ImU64)size.QuadPart : 0;
+#else
+        struct stat st;
+        return fstat(Fd, &st) == 0 ? (ImU64)st.st_size : 0;
+#endif
+    }
+
+    // Reads up to 'size' bytes at 'offset', returns how many were read: fewer at the end of the file. Thread-safe.
+    size_t Read(ImU64 offset, void* dst, size_t size) const {
+        size_t done = 0;
+        while (done < size) {
+#ifdef _WIN32
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = (DWORD)(offset + done);
+            overlapped.OffsetHigh = (DWORD)((offset + done) >> 32);
+            DWORD n = 0;
+            if (!ReadFile(Handle, (char*)dst + done, (DWORD)ImMin(size - done, (size_t)1 << 30), &n, &overlapped) || n == 0)
+                break;
+#else
+            ssize_t n = pread(Fd, (char*)dst + done, size - done, (off_t)(offset + done));
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                break;
+#endif
+            done += (size_t)n;
+        }
+        return done;
+    }
+};
+
+// Mapping of a file that may grow, read-only unless opened writable. On 64-bit POSIX the view reserves address
+// space past the end of the file so appended bytes become readable without remapping; elsewhere Remap() has to be called.
+// Only for files no one else shrinks: touching mapped pages past the end of the file raises SIGBUS, see ImFile.
+struct ImFileMapping {
+    ImFile      File;
+    char*       Data = nullptr;
+    ImU64       Size = 0;       // Bytes of the file covered by Data
+    ImU64       Reserved = 0;   // Bytes of address space reserved for Data
+    bool        Writable = false;
+#ifdef _WIN32
+    HANDLE      Mapping = nullptr;
+#endif
+
+    ImFileMapping() = default;
+    ImFileMapping(const ImFileMapping&) = delete;
+    ImFileMapping& operator=(const ImFileMapping&) = delete;
+    ~ImFileMapping() { Close(); }
+
+    bool IsOpen() const { return File.IsOpen(); }
+
+    // A writable mapping creates the file, or truncates it, and is grown with Resize()
+    bool Open(const char* path, bool writable = false) {
+        Close();
+        Writable = writable;
+        return File.Open(path, writable) && Remap(File.QueryFileSize());
+    }
+
+    bool Resize(ImU64 size) {
+        IM_ASSERT(Writable);
+#ifdef _WIN32
+        // The view can't outgrow its mapping, CreateFileMapping() extends the file when remapping
+        Unmap();
+        LARGE_INTEGER li;
+        li.QuadPart = (LONGLONG)size;
+        if (!SetFilePointerEx(File.Handle, li, nullptr, FILE_BEGIN) || !SetEndOfFile(File.Handle))
+            return false;
+#else
+        if (ftruncate(File.Fd, (off_t)size) != 0)
+            return false;
+#endif
+        return Remap(size);
+    }
+
+    void Close() {
+        Unmap();
+        File.Close();
+    }
+
+    ImU64 QueryFileSize() const { return File.QueryFileSize(); }
+
+    // Makes the first 'size' bytes of the file readable through Data, only remapping when the reservation is exceeded
+    bool Remap(ImU64 size) {
+        if (Data && size <= Reserved) {
+            Size = size;
+            return true;
+        }
+        Unmap();
+        Size = size;
+        if (size == 0)
+            return true;
+#ifdef _WIN32
+        Mapping = CreateFileMappingA(File.Handle, nullptr, Writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+        if (!Mapping)
+            return false;
+        Data = (char*)MapViewOfFile(Mapping, Writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+        Reserved = size;
+#else
+        const ImU64 headroom = sizeof(void*) >= 8 ? ((ImU64)1 << 36) : 0;
+        const ImU64 page = (ImU64)sysconf(_SC_PAGESIZE);
+        Reserved = ((size + page - 1) / page) * page + headroom;
+        void* p = mmap(nullptr, (size_t)Reserved, Writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, File.Fd, 0);
+        Data = (p == MAP_FAILED) ? nullptr : (char*)p;
+#endif
+        if (!Data)
+            Size = Reserved = 0;
+        return Data != nullptr;
+    }
+
+    void Unmap() {
+#ifdef _WIN32
+        if (Data)
+            UnmapViewOfFile(Data);
+        if (Mapping)
+            CloseHandle(Mapping);
+        Mapping = nullptr;
+#else
+        if (Data)
+            munmap((void*)Data, (size_t)Reserved);
+#endif
+        Data = nullptr;
+        Size = Reserved = 0;
+    }
+};
+
+// Appends base + offset + 1 for every '\n' in data[0, size)
+static void ScanLineStarts(const char* data, ImU64 size, ImU64 base, std::vector<ImU64>& out) {
+    ImU64 i = 0;
+#if defined(__AVX2__)
+    const __m256i nl32 = _mm256_set1_epi8('\n');
+    for (; i + 32 <= size; i += 32) {
+        ImU32 mask = (ImU32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + i)), nl32));
+        while (mask) {
+            out.push_back(base + i + CountTrailingZeros(mask) + 1);
+            mask &= mask - 1;
+        }
+    }
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i nl16 = _mm_set1_epi8('\n');
+    for (; i + 16 <= size; i += 16) {
+        ImU32 mask = (ImU32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + i)), nl16));
+        while (mask) {
+            out.push_back(base + i + CountTrailingZeros(mask) + 1);
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < size; i++)
+        if (data[i] == '\n')
+            out.push_back(base + i + 1);
+}
+
+/*
+    TASK POOL
+*/
+
+// One unit of background work. Owner ties it to the widget that submitted it: when that widget is not drawn for a
+// frame its queued tasks move behind visible work, after StaleFrames they are dropped and running ones cancelled.
+struct ImWidgetsTask {
+    enum State_ { State_Queued, State_Running, State_Done, State_Dropped };
+
+    std::function<void()>   Fn;
+    ImGuiID                 Owner = 0;
+    std::atomic<bool>*      Cancel = nullptr;       // Set when the owner goes stale, must outlive the task
+    std::atomic<int>        Priority{ ImTaskPriority_Visible };
+    std::atomic<int>        State{ State_Queued };
+    int                     Queue = 0;              // Deque it waits in, for the stats
+    bool                    Helper = false;         // Extra hands of a ParallelFor(), nothing is lost when dropped
+    std::chrono::steady_clock::time_point QueuedTime;
+
+    bool Finished() const { const int s = State.load(); return s == State_Done || s == State_Dropped; }
+    bool TryDrop() { int expected = State_Queued; return State.compare_exchange_strong(expected, State_Dropped); }
+};
+typedef std::shared_ptr<ImWidgetsTask> ImWidgetsTaskRef;
+
+struct ImWidgetsTaskWorker {
+    std::mutex                      Mutex;
+    std::deque<ImWidgetsTaskRef>    Queues[ImTaskPriority_COUNT];   // The worker pops the back, thieves take the front
+    std::thread                     Thread;
+    bool                            Running = false;                // Thread not exited yet, under the pool's Mutex
+};
+
+static thread_local int GImWidgetsWorkerIndex = -1;
+static thread_local int GImWidgetsTaskPriority = ImTaskPriority_Visible;
+
+// Work-stealing pool behind every background job and parallel loop, shared by all contexts. Tasks are pushed to the
+// submitting worker's deque (round robin from other threads); idle workers take visible work first, their own newest,
+// then the oldest of others.
+struct ImWidgetsTaskPool {
+    std::vector<std::unique_ptr<ImWidgetsTaskWorker>> Workers;     // The first Active take tasks, the others are retired
+    std::shared_mutex       WorkersMutex;           // Exclusive while workers are added, woken or retired
+    std::mutex              Mutex;                  // Sleeping workers and stats
+    std::condition_variable WakeUp;
+    std::atomic<int>        Active{ 0 };
+    std::atomic<int>        Queued{ 0 };
+    std::atomic<unsigned>   NextWorker{ 0 };
+    std::atomic<bool>       Stop{ false };
+    std::atomic<bool>       Promoted{ false };      // A demoted task became visible again, see Pop()
+    std::atomic<int>        RequestedThreads{ -1 };
+    ImTaskQueueStats        Stats[ImTaskPriority_COUNT] = {};
+
+    ~ImWidgetsTaskPool() { StopWorkers(); }
+
+    static int DefaultThreads() { return ImMax((int)std::thread::hardware_concurrency() - 1, 1); }
+
+    void StopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Stop = true;
+        }
+        WakeUp.notify_all();
+        for (auto& worker : Workers)
+            if (worker->Thread.joinable())
+                worker->Thread.join();
+    }
+
+    // Sets the number of workers taking tasks without waiting on any: retired workers exit once their running task
+    // returned and their queued tasks move to the others, workers needed again carry on or are started anew
+    void Resize(int threads, bool only_if_empty = false) {
+        std::unique_lock<std::shared_mutex> workers_lock(WorkersMutex);
+        if (only_if_empty ? Active > 0 : Active == threads)
+            return;
+        std::lock_guard<std::mutex> lock(Mutex);
+        while ((int)Workers.size() < threads)
+            Workers.emplace_back(new ImWidgetsTaskWorker());
+        Active = threads;
+        for (int i = 0; i < threads; i++) {
+            ImWidgetsTaskWorker& worker = *Workers[i];
+            if (worker.Running)
+                continue;
+            // Gone, or past its last look at Active and only returning
+            if (worker.Thread.joinable())
+                worker.Thread.join();
+            worker.Running = true;
+            worker.Thread = std::thread([this, i]() { WorkerMain(i); });
+        }
+        int next = 0;
+        for (size_t i = threads; i < Workers.size(); i++)
+            for (int p = 0; p < ImTaskPriority_COUNT; p++) {
+                for (ImWidgetsTaskRef& task : Workers[i]->Queues[p])
+                    Workers[next++ % threads]->Queues[p].push_back(std::move(task));
+                Workers[i]->Queues[p].clear();
+            }
+        WakeUp.notify_all();
+    }
+
+    void EnsureWorkers() {
+        if (Active > 0)
+            return;
+        const int requested = RequestedThreads;
+        Resize(requested > 0 ? requested : DefaultThreads(), true);
+    }
+
+    int WorkersCount() {
+        EnsureWorkers();
+        return Active;
+    }
+
+    // Applies SetWorkerThreadCount() once workers are running, from the NewFrame hook of any context
+    void ApplyRequestedThreads() {
+        const int requested = RequestedThreads;
+        if (requested > 0 && Active > 0 && Active != requested)
+            Resize(requested);
+    }
+
+    ImWidgetsTaskRef Submit(ImGuiID owner, ImTaskPriority priority, std::atomic<bool>* cancel, std::function<void()> fn, bool helper = false) {
+        EnsureWorkers();
+        ImWidgetsTaskRef task = std::make_shared<ImWidgetsTask>();
+        task->Fn = std::move(fn);
+        task->Helper = helper;
+        task->Owner = owner;
+        task->Cancel = cancel;
+        task->Priority = priority;
+        task->Queue = priority;
+        task->QueuedTime = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Stats[priority].Submitted++;
+            Stats[priority].Pending++;
+        }
+        {
+            std::shared_lock<std::shared_mutex> workers_lock(WorkersMutex);
+            // A worker's own tasks go to the back, where it pops them while their data is still in cache;
+            // other threads' go to the front so that the worker runs them in submission order
+            const int count = Active;
+            const bool own = GImWidgetsWorkerIndex >= 0 && GImWidgetsWorkerIndex < count;
+            const int index = own ? GImWidgetsWorkerIndex : (int)(NextWorker++ % count);
+            std::lock_guard<std::mutex> lock(Workers[index]->Mutex);
+            if (own)
+                Workers[index]->Queues[priority].push_back(task);
+            else
+                Workers[index]->Queues[priority].push_front(task);
+        }
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Queued++;
+        }
+        WakeUp.notify_one();
+        return task;
+    }
+
+    // Newest task of the worker's own deque, else the oldest of another's; queued tasks whose owner
+    // went out of sight are moved to the background deque when met in the visible one, and back once drawn again
+    ImWidgetsTaskRef Pop(int index, bool* stolen) {
+        std::shared_lock<std::shared_mutex> workers_lock(WorkersMutex);
+        const int count = Active;
+        if (index >= count)
+            return nullptr;
+        if (Promoted.exchange(false))
+            for (int k = 0; k < count; k++)
+                PromoteVisible(*Workers[k]);
+        for (int p = 0; p < ImTaskPriority_COUNT; p++) {
+            for (int k = 0; k < count; k++) {
+                ImWidgetsTaskWorker& worker = *Workers[(index + k) % count];
+                std::lock_guard<std::mutex> lock(worker.Mutex);
+                std::deque<ImWidgetsTaskRef>& queue = worker.Queues[p];
+                while (!queue.empty()) {
+                    ImWidgetsTaskRef task;
+                    if (k == 0) {
+                        task = std::move(queue.back());
+                        queue.pop_back();
+                    } else {
+                        task = std::move(queue.front());
+                        queue.pop_front();
+                    }
+                    if (p == ImTaskPriority_Visible && task->Priority == ImTaskPriority_Background && task->State == ImWidgetsTask::State_Queued) {
+                        {
+                            std::lock_guard<std::mutex> stats_lock(Mutex);
+                            Stats[ImTaskPriority_Visible].Pending--;
+                            Stats[ImTaskPriority_Background].Pending++;
+                        }
+                        task->Queue = ImTaskPriority_Background;
+                        worker.Queues[ImTaskPriority_Background].push_back(std::move(task));
+                        continue;
+                    }
+                    Queued--;
+                    *stolen = k != 0;
+                    return task;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // Moves the queued tasks of the background deque whose owner is visible again to the visible one
+    void PromoteVisible(ImWidgetsTaskWorker& worker) {
+        std::lock_guard<std::mutex> lock(worker.Mutex);
+        std::deque<ImWidgetsTaskRef>& background = worker.Queues[ImTaskPriority_Background];
+        int moved = 0;
+        for (size_t i = 0; i < background.size();) {
+            ImWidgetsTask& task = *background[i];
+            if (task.Priority != ImTaskPriority_Visible || task.State != ImWidgetsTask::State_Queued) {
+                i++;
+                continue;
+            }
+            task.Queue = ImTaskPriority_Visible;
+            worker.Queues[ImTaskPriority_Visible].push_back(std::move(background[i]));
+            background.erase(background.begin() + i);
+            moved++;
+        }
+        if (moved == 0)
+            return;
+        std::lock_guard<std::mutex> stats_lock(Mutex);
+        Stats[ImTaskPriority_Background].Pending -= moved;
+        Stats[ImTaskPriority_Visible].Pending += moved;
+    }
+
+    // Tasks dropped while queued are only counted once a worker takes them out, unused helpers are taken back
+    void Run(ImWidgetsTask& task, bool stolen) {
+        const int priority = task.Queue;
+        int expected = ImWidgetsTask::State_Queued;
+        if (!task.State.compare_exchange_strong(expected, ImWidgetsTask::State_Running)) {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Stats[priority].Pending--;
+            if (task.Helper)
+                Stats[priority].Submitted--;
+            else
+                Stats[priority].Dropped++;
+            return;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const int outer_priority = GImWidgetsTaskPriority;
+        GImWidgetsTaskPriority = priority;
+        {
+            std::function<void()> fn = std::move(task.Fn);
+            fn();
+        }
+        GImWidgetsTaskPriority = outer_priority;
+        const auto end = std::chrono::steady_clock::now();
+        task.State = ImWidgetsTask::State_Done;
+
+        const float wait_ms = std::chrono::duration<float, std::milli>(start - task.QueuedTime).count();
+        const float run_ms = std::chrono::duration<float, std::milli>(end - start).count();
+        std::lock_guard<std::mutex> lock(Mutex);
+        ImTaskQueueStats& stats = Stats[priority];
+        stats.Pending--;
+        stats.AvgWaitMs = stats.Completed ? stats.AvgWaitMs + (wait_ms - stats.AvgWaitMs) * 0.05f : wait_ms;
+        stats.AvgRunMs = stats.Completed ? stats.AvgRunMs + (run_ms - stats.AvgRunMs) * 0.05f : run_ms;
+        stats.MaxWaitMs = ImMax(stats.MaxWaitMs, wait_ms);
+        stats.Completed++;
+        stats.Stolen += stolen ? 1 : 0;
+    }
+
+    // Returns when the pool stops or Resize() retires the worker, Pop() giving it nothing from then on
+    void WorkerMain(int index) {
+        GImWidgetsWorkerIndex = index;
+        while (!Stop) {
+            bool stolen = false;
+            if (ImWidgetsTaskRef task = Pop(index, &stolen)) {
+                Run(*task, stolen);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(Mutex);
+            WakeUp.wait(lock, [&] { return Stop || index >= Active || Queued.load() > 0; });
+            if (index >= Active) {
+                Workers[index]->Running = false;
+                return;
+            }
+        }
+    }
+};
+
+static ImWidgetsTaskPool GImWidgetsTaskPool;
+
+// Widgets of one context owning tasks. When an owner is not drawn for a frame its queued tasks move behind visible
+// work, after StaleFrames they are dropped and running ones cancelled. UI thread only
+struct ImWidgetsTaskOwners : ImWidgetsContextData {
+    static const int        StaleFrames = 60;
+
+    int                     Frame = 0;
+    std::unordered_map<ImGuiID, int> OwnersLastFrame;
+    std::vector<ImWidgetsTaskRef> OwnedTasks;
+
+    // Submitting from the owner's draw counts as drawing it this frame
+    void Track(ImGuiID owner, const ImWidgetsTaskRef& task) {
+        OwnersLastFrame[owner] = Frame;
+        OwnedTasks.push_back(task);
+    }
+
+    void KeepAlive(ImGuiID owner) {
+        OwnersLastFrame[owner] = Frame;
+    }
+
+    // Start of every frame: demote or expire the tasks of owners that were not drawn
+    void NewFrame() override {
+        GImWidgetsTaskPool.ApplyRequestedThreads();
+        Frame++;
+        for (size_t i = 0; i < OwnedTasks.size();) {
+            ImWidgetsTask& task = *OwnedTasks[i];
+            if (task.Finished()) {
+                OwnedTasks[i] = std::move(OwnedTasks.back());
+                OwnedTasks.pop_back();
+                continue;
+            }
+            auto it = OwnersLastFrame.find(task.Owner);
+            const int age = it != OwnersLastFrame.end() ? Frame - it->second : INT_MAX;
+            if (age > StaleFrames) {
+                if (task.Cancel)
+                    *task.Cancel = true;
+                task.TryDrop();
+            } else {
+                const int priority = age <= 1 ? ImTaskPriority_Visible : ImTaskPriority_Background;
+                if (task.Priority.exchange(priority) == ImTaskPriority_Background && priority == ImTaskPriority_Visible)
+                    GImWidgetsTaskPool.Promoted = true;
+            }
+            i++;
+        }
+        for (auto it = OwnersLastFrame.begin(); it != OwnersLastFrame.end();)
+            it = Frame - it->second > StaleFrames * 4 ? OwnersLastFrame.erase(it) : std::next(it);
+    }
+};
+
+// Queues fn on the pool. cancel, when given, is set if the owner widget stops being drawn and must outlive the task.
+// A task with an owner is submitted from the UI thread of the owner's context
+static ImWidgetsTaskRef SubmitTask(ImGuiID owner, std::atomic<bool>* cancel, std::function<void()> fn) {
+    ImWidgetsTaskRef task = GImWidgetsTaskPool.Submit(owner, ImTaskPriority_Visible, cancel, std::move(fn));
+    if (owner)
+        GetContextData<ImWidgetsTaskOwners>(ImWidgetsContextSlot_TaskOwners).Track(owner, task);
+    return task;
+}
+
+// Marks the widget as drawn this frame, keeping its tasks at visible priority. UI thread only
+static void KeepTaskOwnerAlive(ImGuiID owner) {
+    GetContextData<ImWidgetsTaskOwners>(ImWidgetsContextSlot_TaskOwners).KeepAlive(owner);
+}
+
+// Drops the task if it has not started, else waits for it to return. Set its cancel flag first
+static void WaitTask(const ImWidgetsTaskRef& task) {
+    if (!task)
+        return;
+    if (task->TryDrop())
+        return;
+    while (!task->Finished())
+        std::this_thread::yield();
+}
+
+// True once a task ended without its job completing: cancelled or dropped for a stale owner, the job has to start over
+static bool TaskAbandoned(const ImWidgetsTaskRef& task, const std::atomic<bool>& done) {
+    return task && task->Finished() && !done;
+}
+
+// Background job of a widget: derived structs add the input and result fields, Start() runs fn on the pool and sets
+// Done unless cancelled. Held in an ImWidgetsJobPtr, which cancels and waits for the task before the fields go away
+struct ImWidgetsJob {
+    ImWidgetsTaskRef    Task;
+    std::atomic<bool>   Done{ false };
+    std::atomic<bool>   Cancel{ false };
+
+    void Start(ImGuiID owner, std::function<void()> fn) {
+        Task = SubmitTask(owner, &Cancel, [this, fn]() {
+            fn();
+            Done = !Cancel;
+        });
+    }
+
+    bool Abandoned() const { return TaskAbandoned(Task, Done); }
+};
+
+struct ImWidgetsJobDeleter {
+    template<typename T>
+    void operator()(T* job) const {
+        job->Cancel = true;
+        WaitTask(job->Task);
+        delete job;
+    }
+};
+template<typename T> using ImWidgetsJobPtr = std::unique_ptr<T, ImWidgetsJobDeleter>;
+
+// Marks owner as drawn, then tells whether its job has to start over: its input changed, or it was cancelled or
+// dropped while the owner was out of sight. UI thread only
+static bool JobOutdated(ImGuiID owner, const ImWidgetsJob* job, bool input_changed) {
+    KeepTaskOwnerAlive(owner);
+    return input_changed || (job && job->Abandoned());
+}
+
+// Runs fn(0) .. fn(count - 1) on the calling thread and idle workers, returns when all have run.
+// Helpers inherit the priority of the task calling it
+static void ParallelFor(int count, const std::function<void(int)>& fn) {
+    const int helpers = ImMin(count - 1, GImWidgetsTaskPool.WorkersCount());
+    std::atomic<int> next{ 0 };
+    auto body = [&]() {
+        for (int i = next++; i < count; i = next++)
+            fn(i);
+    };
+    std::vector<ImWidgetsTaskRef> tasks;
+    for (int i = 0; i < helpers; i++)
+        tasks.push_back(GImWidgetsTaskPool.Submit(0, GImWidgetsTaskPriority, nullptr, body, true));
+    body();
+    // Helpers that have not started yet have nothing left to do
+    for (const ImWidgetsTaskRef& task : tasks)
+        if (!task->TryDrop())
+            while (!task->Finished())
+                std::this_thread::yield();
+}
+
+// Parts to split pool work in: one per worker, following SetWorkerThreadCount()
+static int TaskPoolThreads() {
+    return GImWidgetsTaskPool.WorkersCount();
+}
+
+void ImWidgets::SetWorkerThreadCount(int count) {
+    GImWidgetsTaskPool.RequestedThreads = count < 0 ? -1 : ImMax(count, 1);
+}
+
+void ImWidgets::GetTaskQueueStats(ImTaskQueueStats out_stats[ImTaskPriority_COUNT]) {
+    std::lock_guard<std::mutex> lock(GImWidgetsTaskPool.Mutex);
+    for (int p = 0; p < ImTaskPriority_COUNT; p++)
+        out_stats[p] = GImWidgetsTaskPool.Stats[p];
+}
+
+/*
+    TEXT SEARCH
+*/
+
+// Appends every p in [begin, end) where data[p, p + n) == needle, never reading at or past 'limit'.
+// Candidates are filtered on the needle's first byte and its last byte that differs from it (so runs of
+// the first byte, like the zeros of a binary file, don't all become candidates) a vector at a time before comparing.
+static void FindAllSubstrings(const char* data, ImU64 begin, ImU64 end, ImU64 limit, const char* needle, size_t n, std::vector<ImU64>& out) {
+    if (n == 0 || limit < n)
+        return;
+    end = ImMin(end, limit - n + 1);
+    size_t k = n - 1;
+    while (k > 0 && needle[k] == needle[0])
+        k--;
+    if (k == 0)
+        k = n - 1;
+    ImU64 p = begin;
+#if defined(__AVX2__)
+    const __m256i first32 = _mm256_set1_epi8(needle[0]);
+    const __m256i last32 = _mm256_set1_epi8(needle[k]);
+    for (; p < end && p + n - 1 + 32 <= limit; p += 32) {
+        __m256i f = _mm256_cmpeq_epi8(first32, _mm256_loadu_si256((const __m256i*)(data + p)));
+        __m256i l = _mm256_cmpeq_epi8(last32, _mm256_loadu_si256((const __m256i*)(data + p + k)));
+        ImU32 mask = (ImU32)_mm256_movemask_epi8(_mm256_and_si256(f, l));
+        while (mask) {
+            ImU64 pos = p + CountTrailingZeros(mask);
+            if (pos < end && memcmp(data + pos, needle, n) == 0)
+                out.push_back(pos);
+            mask &= mask - 1;
+        }
+    }
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i first16 = _mm_set1_epi8(needle[0]);
+    const __m128i last16 = _mm_set1_epi8(needle[k]);
+    for (; p < end && p + n - 1 + 16 <= limit; p += 16) {
+        __m128i f = _mm_cmpeq_epi8(first16, _mm_loadu_si128((const __m128i*)(data + p)));
+        __m128i l = _mm_cmpeq_epi8(last16, _mm_loadu_si128((const __m128i*)(data + p + k)));
+        ImU32 mask = (ImU32)_mm_movemask_epi8(_mm_and_si128(f, l));
+        while (mask) {
+            ImU64 pos = p + CountTrailingZeros(mask);
+            if (pos < end && memcmp(data + pos, needle, n) == 0)
+                out.push_back(pos);
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; p < end; p++)
+        if (data[p] == needle[0] && memcmp(data + p, needle, n) == 0)
+            out.push_back(p);
+}
+
+// Finds all matches of a substring or regex in a buffer or a file on pool tasks.
+// The data is split in fixed-size chunks whose results land in per-chunk slots, so the
+// result index is sorted by construction even though chunks complete out of order.
+// Files are read with ImFile::Read(), a file that shrinks mid-search ends it early instead of faulting.
+// Cancel is also set by the pool when the owner goes stale, the owner then starts over.
+struct ImTextSearch {
+    static const ImU64          ChunkSize = 16 << 20;
+    static const size_t         BlockSize = 1 << 20;    // Bytes of a file read at once
+    static const size_t         MaxLineBytes = 4096;    // Regex matching is limited to the start of long lines
+
+    std::string                 Needle;
+    bool                        Regex = false;
+    std::regex                  Re;
+    const ImFile*               File = nullptr;         // Read from when set, else Data
+    const char*                 Data = nullptr;
+    ImU64                       Size = 0;
+
+    std::vector<ImWidgetsTaskRef> Tasks;
+    std::atomic<bool>           Cancel{ false };
+    std::atomic<int>            NextChunk{ 0 };
+    std::atomic<ImU64>          Scanned{ 0 };
+    std::atomic<ImU64>          MatchCount{ 0 };
+    int                         Generation = 0;     // Owner's data generation the search was started on
+
+    std::mutex                  ResultsMutex;
+    std::vector<std::vector<ImU64>> Results;        // One sorted slot per chunk
+
+    // A worker's view of the data: the buffer itself, or the last block read from the file
+    struct Reader {
+        const ImTextSearch*     Search = nullptr;
+        std::vector<char>       Buffer;
+        ImU64                   Begin = 0;
+        size_t                  Length = 0;
+
+        // Up to 'size' bytes at 'offset', fewer at the end of the data
+        const char* Fetch(ImU64 offset, size_t size, size_t* out_size) {
+            const ImU64 data_size = Search->Size;
+            size = offset < data_size ? (size_t)ImMin((ImU64)size, data_size - offset) : 0;
+            *out_size = size;
+            if (size == 0)
+                return "";
+            if (!Search->File)
+                return Search->Data + offset;
+            if (offset < Begin || offset + size > Begin + Length) {
+                if (Buffer.size() < ImMax(size, BlockSize))
+                    Buffer.resize(ImMax(size, BlockSize));
+                Begin = offset;
+                Length = Search->File->Read(offset, Buffer.data(), (size_t)ImMin((ImU64)Buffer.size(), data_size - offset));
+            }
+            *out_size = (size_t)ImMin((ImU64)size, Begin + Length - offset);
+            return Buffer.data() + (offset - Begin);
+        }
+    };
+
+    ~ImTextSearch() {
+        Cancel = true;
+        for (const ImWidgetsTaskRef& task : Tasks)
+            WaitTask(task);
+    }
+
+    int ChunkCount() const { return (int)((Size + ChunkSize - 1) / ChunkSize); }
+    bool IsDone() const { return Scanned.load() >= Size; }
+    float Progress() const { return Size ? (float)((double)Scanned.load() / (double)Size) : 1.0f; }
+
+    // Searches 'size' bytes of 'file', or of 'data' when file is null. Returns false if the pattern is invalid.
+    bool Start(ImGuiID owner, const std::string& needle, bool regex, const ImFile* file, const char* data, ImU64 size) {
+        Needle = needle;
+        Regex = regex;
+        File = file;
+        Data = data;
+        Size = Needle.empty() ? 0 : size;
+        if (Regex) {
+            try {
+                Re.assign(Needle, std::regex::ECMAScript | std::regex::optimize);
+            } catch (const std::regex_error&) {
+                Size = 0;
+                return false;
+            }
+        }
+        Results.resize(ChunkCount());
+
+        const int worker_count = ImMin(TaskPoolThreads(), ChunkCount());
+        for (int i = 0; i < worker_count; i++)
+            Tasks.push_back(SubmitTask(owner, &Cancel, [this]() { WorkerMain(); }));
+        return true;
+    }
+
+    void WorkerMain() {
+        Reader reader;
+        reader.Search = this;
+        std::vector<ImU64> found;
+        for (int chunk = NextChunk++; chunk < ChunkCount() && !Cancel; chunk = NextChunk++) {
+            ImU64 begin = (ImU64)chunk * ChunkSize;
+            ImU64 end = ImMin(begin + ChunkSize, Size);
+            found.clear();
+            if (Regex)
+                ScanRegex(reader, begin, end, found);
+            else
+                ScanSubstrings(reader, begin, end, found);
+            MatchCount += found.size();
+            {
+                std::lock_guard<std::mutex> lock(ResultsMutex);
+                Results[chunk] = found;
+            }
+            Scanned += end - begin;
+        }
+    }
+
+    // Matches starting in [begin, end), a block at a time, each block read with the n - 1 bytes after it
+    void ScanSubstrings(Reader& reader, ImU64 begin, ImU64 end, std::vector<ImU64>& out) {
+        const size_t n = Needle.size();
+        for (ImU64 block = begin; block < end && !Cancel; block += BlockSize) {
+            const size_t block_size = (size_t)ImMin((ImU64)BlockSize, end - block);
+            size_t length;
+            const char* data = reader.Fetch(block, block_size + n - 1, &length);
+            const size_t first = out.size();
+            FindAllSubstrings(data, 0, block_size, length, Needle.data(), n, out);
+            for (size_t i = first; i < out.size(); i++)
+                out[i] += block;
+        }
+    }
+
+    // Offset of the first '\n' at or after 'offset', Size if none
+    ImU64 FindNewline(Reader& reader, ImU64 offset) {
+        for (;;) {
+            size_t length;
+            const char* data = reader.Fetch(offset, BlockSize, &length);
+            if (length == 0)
+                return Size;
+            if (const char* nl = (const char*)memchr(data, '\n', length))
+                return offset + (ImU64)(nl - data);
+            offset += length;
+        }
+    }
+
+    // Matches of lines starting in [begin, end). libstdc++'s regex recurses per character, so only the first
+    // MaxLineBytes of a line are matched: unbounded lines would overflow the worker's stack.
+    void ScanRegex(Reader& reader, ImU64 begin, ImU64 end, std::vector<ImU64>& out) {
+        ImU64 line = begin > 0 ? FindNewline(reader, begin - 1) + 1 : 0;
+        while (line < end && !Cancel) {
+            size_t length;
+            const char* text = reader.Fetch(line, MaxLineBytes, &length);
+            const char* nl = (const char*)memchr(text, '\n', length);
+            const char* text_end = nl ? nl : text + length;
+            for (std::cregex_iterator it(text, text_end, Re), it_end; it != it_end; ++it)
+                out.push_back(line + (ImU64)it->position());
+            if (nl)
+                line += (ImU64)(nl - text) + 1;
+            else if (length == MaxLineBytes)
+                line = FindNewline(reader, line + length) + 1;
+            else
+                break;
+        }
+    }
+
+    // Calls fn(offset) for matches in [begin, end), in order
+    template<typename FN>
+    void ForEachMatch(ImU64 begin, ImU64 end, FN&& fn) {
+        std::lock_guard<std::mutex> lock(ResultsMutex);
+        // Regex matches are stored with the chunk their line starts in, which may be the previous one
+        for (int chunk = ImMax((int)(begin / ChunkSize) - 1, 0); chunk < (int)Results.size() && (ImU64)chunk * ChunkSize < end; chunk++) {
+            const std::vector<ImU64>& r = Results[chunk];
+            for (auto it = std::lower_bound(r.begin(), r.end(), begin); it != r.end() && *it < end; ++it)
+                fn(*it);
+        }
+    }
+
+    // First match after (or before, when backward) 'offset', wrapping around. Returns false if no match is known yet.
+    bool FindNext(ImU64 offset, bool backward, ImU64* out) {
+        std::lock_guard<std::mutex> lock(ResultsMutex);
+        const int count = (int)Results.size();
+        const int start = (int)ImMin(offset / ChunkSize, (ImU64)count);
+        if (!backward) {
+            for (int chunk = ImMax(start - 1, 0); chunk < count; chunk++) {
+                const std::vector<ImU64>& r = Results[chunk];
+                auto it = std::upper_bound(r.begin(), r.end(), offset);
+                if (it != r.end()) { *out = *it; return true; }
+            }
+            for (int chunk = 0; chunk < count; chunk++)
+                if (!Results[chunk].empty()) { *out = Results[chunk].front(); return true; }
+        } else {
+            for (int chunk = ImMin(start + 1, count - 1); chunk >= 0; chunk--) {
+                const std::vector<ImU64>& r = Results[chunk];
+                auto it = std::lower_bound(r.begin(), r.end(), offset);
+                if (it != r.begin()) { *out = *(it - 1); return true; }
+            }
+            for (int chunk = count - 1; chunk >= 0; chunk--)
+                if (!Results[chunk].empty()) { *out = Results[chunk].back(); return true; }
+        }
+        return false;
+    }
+
+    // Length of the match at 'text', at most up to 'text_end': regex matches have to be re-run
+    size_t MatchLength(const char* text, const char* text_end) const {
+        if (!Regex)
+            return ImMin(Needle.size(), (size_t)(text_end - text));
+        std::cmatch m;
+        if (std::regex_search(text, text_end, m, Re, std::regex_constants::match_continuous))
+            return (size_t)m.length();
+        return 0;
+    }
+};
+
+/*
+    LOG VIEWER
+*/
+
+enum ImLogSeverity {
+    ImLogSeverity_None,
+    ImLogSeverity_Debug,
+    ImLogSeverity_Info,
+    ImLogSeverity_Warning,
+    ImLogSeverity_Error,
+};
+
+static ImLogSeverity DetectLogSeverity(const char* line, const char* line_end) {
+    static const struct { const char* Token; ImLogSeverity Severity; } tokens[] = {
+        { "FATAL", ImLogSeverity_Error }, { "ERROR", ImLogSeverity_Error }, { "WARN", ImLogSeverity_Warning },
+        { "INFO", ImLogSeverity_Info }, { "DEBUG", ImLogSeverity_Debug }, { "TRACE", ImLogSeverity_Debug },
+    };
+    // Severity tags sit near the start of a line, don't scan long lines past their prefix
+    line_end = ImMin(line_end, line + 128);
+    for (const char* p = line; p < line_end; p++) {
+        if (*p < 'D' || *p > 'W')
+            continue;
+        for (const auto& t : tokens) {
+            size_t n = strlen(t.Token);
+            if ((size_t)(line_end - p) >= n && memcmp(p, t.Token, n) == 0)
+                return t.Severity;
+        }
+    }
+    return ImLogSeverity_None;
+}
+
+// Reads the file with ImFile::Read() rather than mapping it: a log truncated in place (copytruncate, '> file')
+// would raise SIGBUS on mapped pages past its new end before the indexer noticed
+struct ImLogViewerState {
+    std::string         Path;
+    ImFile              File;
+
+    // Guarded by Mutex: the indexer only takes it to open the file and publish offsets, the UI while reading visible lines
+    std::mutex          Mutex;
+    std::vector<ImU64>  LineStarts;
+    ImU64               IndexedSize = 0;
+
+    std::thread         Indexer;
+    std::atomic<bool>   Stop{ false };
+    std::atomic<bool>   Failed{ false };
+    std::atomic<int>    Generation{ 0 };    // Bumped when the file is truncated and re-indexed
+
+    // Find bar
+    std::unique_ptr<ImTextSearch> Search;
+    char                Query[256] = "";
+    bool                QueryRegex = false;
+    bool                QueryInvalid = false;
+    ImU64               SearchCursor = 0;
+
+    // Lines are scrolled as 64-bit integers by the viewer's own scrollbar, like HexViewer's rows: as a float window
+    // scroll, a file of 100 M lines is 1.7e9 px tall and offsets there are 128 px apart
+    ImS64               ScrollLine = 0;
+    ImS64               ScrollMaxLine = 0;  // Of the last frame, ScrollLine is at the end when it reaches it
+    ImS64               ScrollToLine = -1;
+
+    ~ImLogViewerState() {
+        Search.reset();
+        Stop = true;
+        if (Indexer.joinable())
+            Indexer.join();
+    }
+
+    void Start(const char* path) {
+        Path = path;
+        LineStarts.push_back(0);
+        Indexer = std::thread([this]() { IndexerMain(); });
+    }
+
+    // Lines are [LineStarts[i], LineStarts[i + 1]), a trailing newline doesn't start a visible line
+    ImS64 LineCount() const {
+        size_t count = LineStarts.size();
+        if (count > 1 && LineStarts.back() == IndexedSize)
+            count--;
+        return (ImS64)count;
+    }
+
+    void IndexerMain() {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            if (!File.Open(Path.c_str())) {
+                Failed = true;
+                return;
+            }
+        }
+
+#ifdef __linux__
+        int notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (notify_fd >= 0)
+            inotify_add_watch(notify_fd, Path.c_str(), IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF);
+#endif
+
+        const size_t chunk_size = 4 << 20;
+        std::vector<char> chunk(chunk_size);
+        std::vector<ImU64> starts;
+        ImU64 scanned = 0;
+        ImU64 size = File.QueryFileSize();
+        while (!Stop) {
+            if (scanned < size) {
+                const size_t n = (size_t)ImMin((ImU64)chunk_size, size - scanned);
+                const size_t length = File.Read(scanned, chunk.data(), n);
+                if (length > 0) {
+                    starts.clear();
+                    ScanLineStarts(chunk.data(), length, scanned, starts);
+                    scanned += length;
+                    std::lock_guard<std::mutex> lock(Mutex);
+                    LineStarts.insert(LineStarts.end(), starts.begin(), starts.end());
+                    IndexedSize = scanned;
+                }
+                if (length == n)
+                    continue;
+                // Short read: the file shrank since its size was queried
+            } else {
+                // Caught up: wait for the file to change
+#ifdef __linux__
+                if (notify_fd >= 0) {
+                    pollfd pfd = { notify_fd, POLLIN, 0 };
+                    if (poll(&pfd, 1, 250) > 0) {
+                        char events[4096];
+                        while (read(notify_fd, events, sizeof(events)) > 0) {}
+                    }
+                } else
+#endif
+                std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            }
+
+            size = File.QueryFileSize();
+            if (size < scanned) {
+                // Truncated or rotated in place: start over
+                std::lock_guard<std::mutex> lock(Mutex);
+                LineStarts.assign(1, 0);
+                IndexedSize = scanned = 0;
+                Generation++;
+            }
+        }
+
+#ifdef __linux__
+        if (notify_fd >= 0)
+            close(notify_fd);
+#endif
+    }
+};
+
+void ImWidgets::LogViewer(const char* label, const char* path, ImLogViewerFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, std::unique_ptr<ImLogViewerState>>& logViewerStates = GetStatePool<std::unique_ptr<ImLogViewerState>>(ImWidgetsContextSlot_LogViewer);
+    std::unique_ptr<ImLogViewerState>& st = logViewerStates[id];
+    if (!st || st->Path != path) {
+        st.reset(new ImLogViewerState());
+        st->Start(path);
+    }
+
+    ImGui::PushID(label);
+    if ((flags & ImLogViewerFlags_Search) && !st->Failed) {
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16.0f);
+        bool changed = ImGui::InputTextWithHint("##find", "Find", st->Query, IM_ARRAYSIZE(st->Query));
+        bool next = ImGui::IsItemFocused() && ImGui::IsKeyPressed(ImGuiKey_Enter);
+        ImGui::SameLine();
+        changed |= ImGui::Checkbox("Regex", &st->QueryRegex);
+        ImGui::SameLine();
+        bool prev = ImGui::Button("<");
+        ImGui::SameLine();
+        next |= ImGui::Button(">");
+        ImGui::SameLine();
+
+        // A search cancelled while the viewer was out of sight starts over
+        KeepTaskOwnerAlive(id);
+        if (changed || (st->Search && (st->Search->Generation != st->Generation || st->Search->Cancel))) {
+            st->Search.reset();
+            st->QueryInvalid = false;
+            if (st->Query[0]) {
+                std::lock_guard<std::mutex> lock(st->Mutex);
+                st->Search.reset(new ImTextSearch());
+                st->Search->Generation = st->Generation;
+                st->QueryInvalid = !st->Search->Start(id, st->Query, st->QueryRegex, &st->File, nullptr, st->IndexedSize);
+            }
+        }
+
+        ImTextSearch* search = st->Search.get();
+        ImU64 match = 0;
+        if (search && (prev || next) && search->FindNext(st->SearchCursor, prev, &match)) {
+            std::lock_guard<std::mutex> lock(st->Mutex);
+            st->SearchCursor = match;
+            st->ScrollToLine = (ImS64)(std::upper_bound(st->LineStarts.begin(), st->LineStarts.end(), match) - st->LineStarts.begin()) - 1;
+        }
+
+        if (st->QueryInvalid)
+            ImGui::TextColored(style.ImLogViewerErrorColor, "Invalid pattern");
+        else if (search && !search->IsDone())
+            ProgressBar("##progress", 0.0f, 100.0f, search->Progress() * 100.0f, ImProgressBarFlags_PercentageLabel);
+        else if (search)
+            ImGui::Text("%llu matches", (unsigned long long)search->MatchCount.load());
+        else
+            ImGui::NewLine();
+    }
+
+    if (!ImGui::BeginChild("##log", style.ImLogViewerSize, ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar)) {
+        ImGui::EndChild();
+        ImGui::PopID();
+        return;
+    }
+
+    if (st->Failed) {
+        ImGui::TextColored(style.ImLogViewerErrorColor, "Unable to open '%s'", path);
+        ImGui::EndChild();
+        ImGui::PopID();
+        return;
+    }
+
+    const bool follow = !(flags & ImLogViewerFlags_NoFollow) && st->ScrollToLine < 0 && st->ScrollLine >= st->ScrollMaxLine;
+    const ImVec4 severity_colors[] = {
+        ImGui::GetStyleColorVec4(ImGuiCol_Text),
+        style.ImLogViewerDebugColor,
+        style.ImLogViewerInfoColor,
+        style.ImLogViewerWarningColor,
+        style.ImLogViewerErrorColor,
+    };
+    const size_t max_line_bytes = ImTextSearch::MaxLineBytes;
+    char* text = FrameAllocArray<char>((int)max_line_bytes + 2);
+    ImTextSearch* search = st->Search.get();
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    ImDrawList* draw_list = window->DrawList;
+    const ImU32 col_match = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+    const ImU32 col_cursor = ImGui::GetColorU32(ImGuiCol_Text);
+    const ImU32 col_line_number = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+
+    // Lines are drawn, not submitted: the content never exceeds the window so it never scrolls vertically itself
+    const ImGuiStyle& imgui_style = ImGui::GetStyle();
+    const float line_height = ImGui::GetTextLineHeight();
+    const float scrollbar_width = imgui_style.ScrollbarSize;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float avail_height = ImGui::GetContentRegionAvail().y;
+    const ImS64 full_lines = ImMax((ImS64)(avail_height / line_height), (ImS64)1);
+    const ImGuiID scroll_id = ImGui::GetID("##scroll");
+    ImGuiIO& io = ImGui::GetIO();
+
+    {
+        std::lock_guard<std::mutex> lock(st->Mutex);
+        const ImS64 line_count = st->LineCount();
+        const std::vector<ImU64>& starts = st->LineStarts;
+
+        // Appends are followed while at the end, then wheel and keys scroll
+        const ImS64 scroll_max = ImMax(line_count - full_lines, (ImS64)0);
+        if (follow)
+            st->ScrollLine = scroll_max;
+        if (ImGui::IsWindowHovered()) {
+            ImGui::SetKeyOwner(ImGuiKey_MouseWheelY, scroll_id);
+            if (io.MouseWheel != 0.0f) {
+                ImS64 step = (ImS64)(io.MouseWheel * 3.0f);
+                st->ScrollLine -= step != 0 ? step : (io.MouseWheel > 0.0f ? 1 : -1);
+            }
+        }
+        if (ImGui::IsWindowFocused()) {
+            if (ImGui::IsKeyPressed(ImGuiKey_PageUp))   st->ScrollLine -= full_lines;
+            if (ImGui::IsKeyPressed(ImGuiKey_PageDown)) st->ScrollLine += full_lines;
+            if (ImGui::IsKeyPressed(ImGuiKey_Home))     st->ScrollLine = 0;
+            if (ImGui::IsKeyPressed(ImGuiKey_End))      st->ScrollLine = line_count;
+        }
+        if (st->ScrollToLine >= 0) {
+            st->ScrollLine = st->ScrollToLine - full_lines / 2;
+            st->ScrollToLine = -1;
+        }
+        st->ScrollLine = ImClamp(st->ScrollLine, (ImS64)0, scroll_max);
+        const bool has_scrollbar = line_count > full_lines;
+        const ImRect clip = window->InnerClipRect;
+        const ImRect scrollbar(ImVec2(window->InnerRect.Max.x - scrollbar_width, window->InnerRect.Min.y), window->InnerRect.Max);
+        if (has_scrollbar)
+            ImGui::ScrollbarEx(scrollbar, scroll_id, ImGuiAxis_Y, &st->ScrollLine, full_lines, line_count, ImDrawFlags_RoundCornersNone);
+        st->ScrollMaxLine = scroll_max;
+
+        const ImS64 first_line = st->ScrollLine;
+        const int lines = (int)ImMin(full_lines + 1, line_count - first_line);
+        char line_number[24];
+        float text_x = origin.x;
+        if (flags & ImLogViewerFlags_LineNumbers) {
+            ImFormatString(line_number, IM_ARRAYSIZE(line_number), "%8lld", (long long)(first_line + lines));
+            text_x += ImGui::CalcTextSize(line_number).x + imgui_style.ItemSpacing.x;
+        }
+
+        float content_width = 0.0f;
+        ImGui::PushClipRect(clip.Min, ImVec2(has_scrollbar ? ImMin(scrollbar.Min.x, clip.Max.x) : clip.Max.x, clip.Max.y), true);
+        for (int r = 0; r < lines; r++) {
+            // Only what is drawn is read, with the line break to trim: a longer line is cut anyway.
+            // A file that shrank since it was indexed reads short until the indexer starts over.
+            const ImS64 line = first_line + r;
+            const ImU64 begin = starts[(size_t)line];
+            const ImU64 line_end = (size_t)line + 1 < starts.size() ? starts[(size_t)line + 1] : st->IndexedSize;
+            const size_t wanted = (size_t)ImMin(line_end - begin, (ImU64)max_line_bytes + 2);
+            size_t length = st->File.Read(begin, text, wanted);
+            if (length == wanted && length == line_end - begin)
+                while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+                    length--;
+            length = ImMin(length, max_line_bytes);
+            const char* text_end = text + length;
+            const ImU64 end = begin + length;
+            const float y = origin.y + r * line_height;
+
+            if (flags & ImLogViewerFlags_LineNumbers) {
+                ImFormatString(line_number, IM_ARRAYSIZE(line_number), "%8lld", (long long)(line + 1));
+                draw_list->AddText(ImVec2(origin.x, y), col_line_number, line_number);
+            }
+            if (search) {
+                search->ForEachMatch(begin, end, [&](ImU64 offset) {
+                    const char* match = text + (offset - begin);
+                    size_t match_length = search->MatchLength(match, text_end);
+                    ImVec2 p_min(text_x + ImGui::CalcTextSize(text, match).x, y);
+                    ImVec2 p_max(p_min.x + ImGui::CalcTextSize(match, match + match_length).x, y + line_height);
+                    draw_list->AddRectFilled(p_min, p_max, col_match);
+                    if (offset == st->SearchCursor)
+                        draw_list->AddRect(p_min, p_max, col_cursor);
+                });
+            }
+            ImLogSeverity severity = (flags & ImLogViewerFlags_NoSeverityColors) ? ImLogSeverity_None : DetectLogSeverity(text, text_end);
+            draw_list->AddText(ImVec2(text_x, y), ImGui::GetColorU32(severity_colors[severity]), text, text_end);
+            content_width = ImMax(content_width, ImGui::CalcTextSize(text, text_end).x);
+        }
+        ImGui::PopClipRect();
+
+        // Width of the widest visible line for the horizontal scrollbar, height of the visible lines only
+        ImGui::Dummy(ImVec2(text_x - origin.x + content_width + (has_scrollbar ? scrollbar_width : 0.0f), ImMin(full_lines * line_height, avail_height)));
+    }
+
+    ImGui::EndChild();
+    ImGui::PopID();
+}
+
+/*
+    DATA GRID
+*/
+
+typedef double (*ImDataGridReader)(const char* p);
+template<typename T> static double DataGridRead(const char* p) { return (double)*(const T*)p; }
+
+static ImDataGridReader DataGridGetReader(ImGuiDataType data_type) {
+    switch (data_type) {
+        case ImGuiDataType_S8:      return DataGridRead<ImS8>;
+        case ImGuiDataType_U8:      return DataGridRead<ImU8>;
+        case ImGuiDataType_S16:     return DataGridRead<ImS16>;
+        case ImGuiDataType_U16:     return DataGridRead<ImU16>;
+        case ImGuiDataType_S32:     return DataGridRead<ImS32>;
+        case ImGuiDataType_U32:     return DataGridRead<ImU32>;
+        case ImGuiDataType_S64:     return DataGridRead<ImS64>;
+        case ImGuiDataType_U64:     return DataGridRead<ImU64>;
+        case ImGuiDataType_Float:   return DataGridRead<float>;
+        case ImGuiDataType_Double:  return DataGridRead<double>;
+        default:                    return nullptr;
+    }
+}
+
+static int DataGridStride(const ImDataGridColumn& col) {
+    return col.Stride ? col.Stride : (int)ImGui::DataTypeGetInfo(col.DataType)->Size;
+}
+
+static const char* DataGridCellText(const ImDataGridColumn& col, int row, char* buf, int buf_size) {
+    if (col.GetText)
+        return col.GetText(col.UserData, row, buf, buf_size);
+    if (col.Data) {
+        const char* p = (const char*)col.Data + (size_t)row * DataGridStride(col);
+        ImGui::DataTypeFormatString(buf, buf_size, col.DataType, p, col.Format ? col.Format : ImGui::DataTypeGetInfo(col.DataType)->PrintFmt);
+    } else if (col.GetValue) {
+        ImFormatString(buf, buf_size, col.Format ? col.Format : "%g", col.GetValue(col.UserData, row));
+    } else {
+        buf[0] = 0;
+    }
+    return buf;
+}
+
+// Sorts 'index' with std::sort in a part per pool worker, then merges the sorted parts pairwise in parallel
+template<typename LESS>
+static void ParallelSortIndex(std::vector<int>& index, LESS less, const std::atomic<bool>& cancel) {
+    const size_t min_part_size = 1 << 16;
+    const int parts = (int)ImMin((size_t)TaskPoolThreads(), ImMax(index.size() / min_part_size, (size_t)1));
+    std::vector<size_t> bounds(parts + 1);
+    for (int i = 0; i <= parts; i++)
+        bounds[i] = index.size() * i / parts;
+
+    auto it = index.begin();
+    ParallelFor(parts, [&](int i) { std::sort(it + bounds[i], it + bounds[i + 1], less); });
+    for (int width = 1; width < parts && !cancel; width *= 2) {
+        ParallelFor((parts + 2 * width - 1) / (2 * width), [&](int m) {
+            int lo = m * 2 * width;
+            int mid = ImMin(lo + width, parts);
+            int hi = ImMin(lo + 2 * width, parts);
+            if (mid < hi)
+                std::inplace_merge(it + bounds[lo], it + bounds[mid], it + bounds[hi], less);
+        });
+    }
+}
+
+struct ImDataGridSortJob : ImWidgetsJob {
+    std::vector<int>    Index;
+    int                 RowsCount = 0;      // Rows covered by Index, rows appended since come after them
+};
+
+struct ImDataGridState {
+    int                 RowsCount = 0;
+    int                 DataVersion = 0;
+    int                 SortColumn = -1;
+    bool                SortDescending = false;
+    ImWidgetsJobPtr<ImDataGridSortJob> SortJob;
+    std::vector<ImWidgetsJobPtr<ImDataGridSortJob>> SortJobsCancelled;  // Kept until their task returned so releasing them doesn't block
+    std::vector<int>    Sorted;             // Every row, in sort order
+
+    // Filtering walks FilterSource a slice per frame, pushing matches to FilterOut, then swaps it into View
+    char                Filter[128] = "";
+    std::string         FilterApplied;
+    bool                Filtered = false;   // View (or FilterOut while in progress) is the displayed subset of Sorted
+    bool                Filtering = false;
+    std::vector<int>    FilterSource;
+    size_t              FilterPos = 0;
+    std::vector<int>    FilterOut;
+    std::vector<int>    View;
+
+    std::vector<float>  ColumnWidths;
+
+    const std::vector<int>& DisplayRows() const { return !Filtered ? Sorted : Filtering ? FilterOut : View; }
+
+    void StartFilter(bool narrow) {
+        Filtering = Filtered = false;
+        FilterSource.clear();
+        FilterOut.clear();
+        FilterPos = 0;
+        if (FilterApplied.empty()) {
+            View.clear();
+            return;
+        }
+        // Rows matching a longer filter are a subset of the rows matching the previous one
+        if (narrow)
+            FilterSource.swap(View);
+        else
+            FilterSource = Sorted;
+        View.clear();
+        Filtering = Filtered = true;
+    }
+
+    // With sorted_rows > 0 the first sorted_rows of Sorted are in order and only the rows after them are sorted,
+    // then merged in. Otherwise every row is sorted.
+    void StartSort(ImGuiID owner, const ImDataGridColumn* columns, int sorted_rows = 0) {
+        if (SortJob) {
+            SortJob->Cancel = true;
+            SortJobsCancelled.push_back(std::move(SortJob));
+        }
+        SortJob.reset(new ImDataGridSortJob());
+        ImDataGridSortJob* job = SortJob.get();
+        const ImDataGridColumn col = SortColumn >= 0 ? columns[SortColumn] : ImDataGridColumn();
+        const bool sorted = SortColumn >= 0;
+        const bool descending = SortDescending;
+        const int rows_count = RowsCount;
+        job->RowsCount = rows_count;
+        if (sorted && sorted_rows > 0)
+            job->Index = Sorted;
+        else
+            sorted_rows = 0;
+        job->Start(owner, [job, col, sorted, descending, rows_count, sorted_rows]() {
+            if (sorted_rows == 0) {
+                job->Index.resize(rows_count);
+                for (int i = 0; i < rows_count; i++)
+                    job->Index[i] = i;
+            }
+            if (!sorted)
+                return;
+            auto sort_by = [&](auto less) {
+                if (sorted_rows == 0) {
+                    ParallelSortIndex(job->Index, less, job->Cancel);
+                    return;
+                }
+                std::vector<int> tail(job->Index.begin() + sorted_rows, job->Index.end());
+                ParallelSortIndex(tail, less, job->Cancel);
+                std::copy(tail.begin(), tail.end(), job->Index.begin() + sorted_rows);
+                if (!job->Cancel)
+                    std::inplace_merge(job->Index.begin(), job->Index.begin() + sorted_rows, job->Index.end(), less);
+            };
+            // Ties keep row order. NaN compares false both ways, which breaks the strict weak ordering std::sort
+            // relies on (it then reads out of range): NaNs are ordered explicitly, last in either direction.
+            auto sort_by_value = [&](auto value) {
+                sort_by([&](int a, int b) {
+                    const double value_a = value(a), value_b = value(b);
+                    const bool nan_a = std::isnan(value_a), nan_b = std::isnan(value_b);
+                    if (nan_a || nan_b)
+                        return nan_a == nan_b ? a < b : nan_b;
+                    if (value_a != value_b)
+                        return (value_a < value_b) != descending;
+                    return a < b;
+                });
+            };
+            if (ImDataGridReader read = col.Data ? DataGridGetReader(col.DataType) : nullptr) {
+                const char* base = (const char*)col.Data;
+                const size_t stride = (size_t)DataGridStride(col);
+                sort_by_value([&](int row) { return read(base + row * stride); });
+            } else if (col.GetValue) {
+                sort_by_value([&](int row) { return col.GetValue(col.UserData, row); });
+            } else if (col.GetText) {
+                sort_by([&](int a, int b) {
+                    thread_local char buf_a[256], buf_b[256];
+                    const int cmp = strcmp(col.GetText(col.UserData, a, buf_a, sizeof(buf_a)), col.GetText(col.UserData, b, buf_b, sizeof(buf_b)));
+                    if (cmp != 0)
+                        return (cmp < 0) != descending;
+                    return a < b;
+                });
+            }
+        });
+    }
+
+    void StepFilter(const ImDataGridColumn* columns, int columns_count, float budget_ms) {
+        const char* needle = FilterApplied.c_str();
+        const char* needle_end = needle + FilterApplied.size();
+        char buf[256];
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((ImS64)(budget_ms * 1000.0f));
+        for (; FilterPos < FilterSource.size(); FilterPos++) {
+            if ((FilterPos & 255) == 0 && std::chrono::steady_clock::now() > deadline)
+                break;
+            int row = FilterSource[FilterPos];
+            for (int c = 0; c < columns_count; c++) {
+                const char* text = DataGridCellText(columns[c], row, buf, sizeof(buf));
+                if (ImStristr(text, nullptr, needle, needle_end)) {
+                    FilterOut.push_back(row);
+                    break;
+                }
+            }
+        }
+        if (FilterPos == FilterSource.size()) {
+            View.swap(FilterOut);
+            FilterOut.clear();
+            FilterSource.clear();
+            Filtering = false;
+        }
+    }
+};
+
+void ImWidgets::DataGrid(const char* label, const ImDataGridColumn* columns, int columns_count, int rows_count, int data_version, ImDataGridFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, ImDataGridState>& dataGridStates = GetStatePool<ImDataGridState>(ImWidgetsContextSlot_DataGrid);
+    ImDataGridState& st = dataGridStates[id];
+
+    // Data changes: appended rows extend the index and the pending filter, anything else starts over.
+    // Sorted, appended rows are merged into the order: right away when it is current, else once the pending sort is done.
+    if (rows_count != st.RowsCount || data_version != st.DataVersion) {
+        if (rows_count > st.RowsCount && data_version == st.DataVersion) {
+            const int sorted_rows = st.RowsCount;
+            size_t first_new = st.Sorted.size();
+            for (int row = st.RowsCount; row < rows_count; row++)
+                st.Sorted.push_back(row);
+            if (st.Filtered && !st.Filtering) {
+                st.FilterOut.swap(st.View);
+                st.FilterSource.assign(st.Sorted.begin() + first_new, st.Sorted.end());
+                st.FilterPos = 0;
+                st.Filtering = true;
+            } else if (st.Filtering) {
+                st.FilterSource.insert(st.FilterSource.end(), st.Sorted.begin() + first_new, st.Sorted.end());
+            }
+            st.RowsCount = rows_count;
+            if (st.SortColumn >= 0 && !st.SortJob)
+                st.StartSort(id, columns, sorted_rows);
+        } else {
+            st.RowsCount = rows_count;
+            st.Sorted.resize(rows_count);
+            for (int row = 0; row < rows_count; row++)
+                st.Sorted[row] = row;
+            st.StartFilter(false);
+            if (st.SortColumn >= 0)
+                st.StartSort(id, columns);
+        }
+        st.DataVersion = data_version;
+    }
+
+    // A sort cancelled while the grid was out of sight starts over
+    st.SortJobsCancelled.erase(std::remove_if(st.SortJobsCancelled.begin(), st.SortJobsCancelled.end(),
+        [](const ImWidgetsJobPtr<ImDataGridSortJob>& job) { return job->Task->Finished(); }), st.SortJobsCancelled.end());
+    if (JobOutdated(id, st.SortJob.get(), false))
+        st.StartSort(id, columns);
+    if (st.SortJob && st.SortJob->Done) {
+        const int sorted_rows = st.SortJob->RowsCount;
+        st.Sorted.swap(st.SortJob->Index);
+        st.SortJob.reset();
+        for (int row = sorted_rows; row < st.RowsCount; row++)
+            st.Sorted.push_back(row);
+        if (sorted_rows < st.RowsCount && st.SortColumn >= 0)
+            st.StartSort(id, columns, sorted_rows);
+        st.StartFilter(false);
+    }
+
+    ImGui::PushID(label);
+
+    if (!(flags & ImDataGridFlags_NoFilter)) {
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16.0f);
+        if (ImGui::InputTextWithHint("##filter", "Filter", st.Filter, IM_ARRAYSIZE(st.Filter))) {
+            bool narrow = !st.FilterApplied.empty() && !st.Filtering && strstr(st.Filter, st.FilterApplied.c_str()) != nullptr;
+            st.FilterApplied = st.Filter;
+            st.StartFilter(narrow);
+        }
+        ImGui::SameLine();
+        ImGui::Text("%d / %d rows", (int)st.DisplayRows().size(), rows_count);
+        if (st.SortJob || st.Filtering) {
+            ImGui::SameLine();
+            Spinner("##busy", ImSpinnerFlags_NoLabel);
+        }
+    }
+
+    if (st.Filtering)
+        st.StepFilter(columns, columns_count, style.ImDataGridFilterTimeBudget);
+
+    // Initial column widths are measured once from the header and the first rows
+    if ((int)st.ColumnWidths.size() != columns_count) {
+        st.ColumnWidths.assign(columns_count, 0.0f);
+        char buf[256];
+        for (int c = 0; c < columns_count; c++) {
+            float w = ImGui::CalcTextSize(columns[c].Name).x + ImGui::GetFontSize();
+            for (int row = 0; row < ImMin(rows_count, 64); row++)
+                w = ImMax(w, ImGui::CalcTextSize(DataGridCellText(columns[c], row, buf, sizeof(buf))).x);
+            st.ColumnWidths[c] = w;
+        }
+    }
+
+    ImGuiTableFlags table_flags = ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter |
+        ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable;
+    if (!(flags & ImDataGridFlags_NoSort))
+        table_flags |= ImGuiTableFlags_Sortable | ImGuiTableFlags_SortTristate;
+
+    if (ImGui::BeginTable("##grid", columns_count, table_flags, style.ImDataGridSize)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        for (int c = 0; c < columns_count; c++)
+            ImGui::TableSetupColumn(columns[c].Name, ImGuiTableColumnFlags_WidthFixed, st.ColumnWidths[c]);
+        ImGui::TableHeadersRow();
+
+        ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs();
+        if (specs && specs->SpecsDirty) {
+            st.SortColumn = specs->SpecsCount ? specs->Specs[0].ColumnIndex : -1;
+            st.SortDescending = specs->SpecsCount && specs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+            st.StartSort(id, columns);
+            specs->SpecsDirty = false;
+        }
+
+        const std::vector<int>& rows = st.DisplayRows();
+        char buf[256];
+        ImGuiListClipper clipper;
+        clipper.Begin((int)rows.size());
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                ImGui::TableNextRow();
+                for (int c = 0; c < columns_count; c++) {
+                    if (!ImGui::TableSetColumnIndex(c))
+                        continue;
+                    ImGui::TextUnformatted(DataGridCellText(columns[c], rows[i], buf, sizeof(buf)));
+                }
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::PopID();
+}
+
+/*
+    TREE VIEW
+*/
+
+enum ImTreeViewNodeFlags_ {
+    ImTreeViewNodeFlags_HasChildren = 1 << 0,
+    ImTreeViewNodeFlags_Expanded    = 1 << 1,
+    ImTreeViewNodeFlags_Loading     = 1 << 2,
+    ImTreeViewNodeFlags_Loaded      = 1 << 3,
+};
+
+struct ImTreeViewNode {
+    ImU64   Id;
+    int     Parent;
+    int     FirstChild;     // Children are contiguous in ImTreeViewState::Nodes
+    int     ChildCount;
+    int     Label;          // Offset into ImTreeViewState::Labels
+    int     Depth;
+    int     Flags;
+};
+
+struct ImTreeViewLoadJob : ImWidgetsJob {
+    int                 Node = 0;
+    ImTreeViewChildren  Children;
+};
+
+struct ImTreeViewState {
+    std::vector<ImTreeViewNode> Nodes;
+    std::vector<char>           Labels;
+    // Flattened visible rows: a node index, or -(node + 1) for the spinner row standing in for a node's children
+    std::vector<int>            Rows;
+    std::vector<ImWidgetsJobPtr<ImTreeViewLoadJob>> Jobs;
+
+    int RowDepth(int row) const {
+        int value = Rows[row];
+        return value >= 0 ? Nodes[value].Depth : Nodes[-value - 1].Depth + 1;
+    }
+
+    // Loaders can't be interrupted: a load that got to run keeps its children even if the tree went stale meanwhile,
+    // only loads still queued are dropped
+    ImWidgetsJobPtr<ImTreeViewLoadJob> StartLoad(ImGuiID owner, int node, ImTreeViewLoadChildrenFn load_children, void* user_data) {
+        Nodes[node].Flags |= ImTreeViewNodeFlags_Loading;
+        ImWidgetsJobPtr<ImTreeViewLoadJob> job(new ImTreeViewLoadJob());
+        ImTreeViewLoadJob* load = job.get();
+        load->Node = node;
+        ImU64 id = Nodes[node].Id;
+        load->Start(owner, [load, id, load_children, user_data]() {
+            load_children(user_data, id, &load->Children);
+            load->Cancel = false;
+        });
+        return job;
+    }
+
+    // Rows below an expanded node: its children and, recursively, those of expanded descendants
+    void AppendVisibleSubtree(int node, std::vector<int>& out) const {
+        const ImTreeViewNode& n = Nodes[node];
+        if (!(n.Flags & ImTreeViewNodeFlags_Loaded)) {
+            out.push_back(-node - 1);
+            return;
+        }
+        for (int child = n.FirstChild; child < n.FirstChild + n.ChildCount; child++) {
+            out.push_back(child);
+            if (Nodes[child].Flags & ImTreeViewNodeFlags_Expanded)
+                AppendVisibleSubtree(child, out);
+        }
+    }
+
+    void Expand(ImGuiID owner, int row, ImTreeViewLoadChildrenFn load_children, void* user_data) {
+        int node = Rows[row];
+        Nodes[node].Flags |= ImTreeViewNodeFlags_Expanded;
+        if (!(Nodes[node].Flags & (ImTreeViewNodeFlags_Loaded | ImTreeViewNodeFlags_Loading)))
+            Jobs.push_back(StartLoad(owner, node, load_children, user_data));
+        std::vector<int> rows;
+        AppendVisibleSubtree(node, rows);
+        Rows.insert(Rows.begin() + row + 1, rows.begin(), rows.end());
+    }
+
+    void Collapse(int row) {
+        int node = Rows[row];
+        Nodes[node].Flags &= ~ImTreeViewNodeFlags_Expanded;
+        int end = row + 1;
+        while (end < (int)Rows.size() && RowDepth(end) > Nodes[node].Depth)
+            end++;
+        Rows.erase(Rows.begin() + row + 1, Rows.begin() + end);
+    }
+
+    void FinishLoad(ImTreeViewLoadJob& job) {
+        const ImTreeViewChildren& children = job.Children;
+        const int parent = job.Node;
+        const int first_child = (int)Nodes.size();
+        Nodes.reserve(Nodes.size() + children.Ids.Size);
+        for (int i = 0; i < children.Ids.Size; i++) {
+            int flags = children.HasChildren[i] ? ImTreeViewNodeFlags_HasChildren : ImTreeViewNodeFlags_Loaded;
+            Nodes.push_back({ children.Ids[i], parent, 0, 0, (int)Labels.size() + children.LabelOffsets[i], Nodes[parent].Depth + 1, flags });
+        }
+        Labels.insert(Labels.end(), children.Labels.begin(), children.Labels.end());
+
+        ImTreeViewNode& n = Nodes[parent];
+        n.FirstChild = first_child;
+        n.ChildCount = children.Ids.Size;
+        n.Flags = (n.Flags & ~ImTreeViewNodeFlags_Loading) | ImTreeViewNodeFlags_Loaded;
+    }
+
+    // Swaps the spinner rows of the nodes that finished loading for their children, in one pass for all loads
+    void ReplaceLoadedPlaceholders() {
+        std::vector<int> rows;
+        rows.reserve(Rows.size());
+        for (int value : Rows) {
+            if (value < 0 && (Nodes[-value - 1].Flags & ImTreeViewNodeFlags_Loaded))
+                AppendVisibleSubtree(-value - 1, rows);
+            else
+                rows.push_back(value);
+        }
+        Rows.swap(rows);
+    }
+};
+
+bool ImWidgets::TreeView(const char* label, ImTreeViewLoadChildrenFn load_children, void* user_data, ImU64* selected_id, ImTreeViewFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, ImTreeViewState>& treeViewStates = GetStatePool<ImTreeViewState>(ImWidgetsContextSlot_TreeView);
+    ImTreeViewState& st = treeViewStates[id];
+    if (st.Nodes.empty()) {
+        // Node 0 is the hidden root, its children are the top level rows
+        st.Nodes.push_back({ 0, -1, 0, 0, 0, -1, ImTreeViewNodeFlags_HasChildren | ImTreeViewNodeFlags_Expanded });
+        st.Labels.push_back(0);
+        st.Rows.push_back(-1);
+        st.Jobs.push_back(st.StartLoad(id, 0, load_children, user_data));
+    }
+
+    // Loads dropped while the tree was out of sight start over
+    bool loaded = false;
+    for (size_t i = 0; i < st.Jobs.size();) {
+        ImTreeViewLoadJob& job = *st.Jobs[i];
+        if (JobOutdated(id, &job, false)) {
+            st.Jobs[i] = st.StartLoad(id, job.Node, load_children, user_data);
+        } else if (job.Done) {
+            st.FinishLoad(job);
+            st.Jobs[i] = std::move(st.Jobs.back());
+            st.Jobs.pop_back();
+            loaded = true;
+            continue;
+        }
+        i++;
+    }
+    if (loaded)
+        st.ReplaceLoadedPlaceholders();
+
+    bool changed = false;
+    ImGui::PushID(label);
+    if (ImGui::BeginChild("##tree", style.ImTreeViewSize, ImGuiChildFlags_Borders)) {
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const float row_height = ImGui::GetTextLineHeight();
+        const float indent = ImGui::GetStyle().IndentSpacing;
+        const ImU32 col_arrow = GetColorU32(ImWidgetsCol_TreeViewArrow);
+        const ImU32 col_text = ImGui::GetColorU32(ImGuiCol_Text);
+        int toggle_row = -1;
+
+        ImGuiListClipper clipper;
+        clipper.Begin((int)st.Rows.size(), row_height + ImGui::GetStyle().ItemSpacing.y);
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const float x = ImGui::GetCursorPosX() + st.RowDepth(row) * indent;
+
+                if (st.Rows[row] < 0) {
+                    ImGui::SetCursorPosX(x + row_height);
+                    PushStyleVar(ImWidgetsStyleVar_SpinnerRadius, row_height * 0.5f - 1.0f);
+                    ImGui::PushID(row);
+                    Spinner("##loading", ImSpinnerFlags_NoLabel);
+                    ImGui::PopID();
+                    PopStyleVar();
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("Loading...");
+                    continue;
+                }
+
+                const ImTreeViewNode& node = st.Nodes[st.Rows[row]];
+                const bool has_children = (node.Flags & ImTreeViewNodeFlags_HasChildren) != 0;
+                const bool selected = selected_id && *selected_id == node.Id;
+
+                ImGui::PushID(st.Rows[row]);
+                bool clicked = ImGui::Selectable("##row", selected, ImGuiSelectableFlags_AllowDoubleClick, ImVec2(0.0f, row_height));
+                ImGui::PopID();
+                ImVec2 p = ImGui::GetItemRectMin();
+                p.x = ImGui::GetWindowPos().x - ImGui::GetScrollX() + x;
+
+                if (has_children) {
+                    ImGuiDir dir = (node.Flags & ImTreeViewNodeFlags_Expanded) ? ImGuiDir_Down : ImGuiDir_Right;
+                    ImGui::RenderArrow(draw_list, ImVec2(p.x, p.y), col_arrow, dir, 0.7f);
+                }
+                draw_list->AddText(ImVec2(p.x + row_height, p.y), col_text, st.Labels.data() + node.Label);
+
+                if (clicked) {
+                    bool on_arrow = ImGui::GetIO().MousePos.x < p.x + row_height;
+                    if (has_children && (on_arrow || ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) || (flags & ImTreeViewFlags_ExpandOnClick)))
+                        toggle_row = row;
+                    if (!on_arrow && selected_id && *selected_id != node.Id) {
+                        *selected_id = node.Id;
+                        changed = true;
+                    }
+                }
+            }
+        }
+        clipper.End();
+
+        if (toggle_row >= 0) {
+            if (st.Nodes[st.Rows[toggle_row]].Flags & ImTreeViewNodeFlags_Expanded)
+                st.Collapse(toggle_row);
+            else
+                st.Expand(id, toggle_row, load_children, user_data);
+        }
+    }
+    ImGui::EndChild();
+    ImGui::PopID();
+    return changed;
+}
+
+/*
+    DECIMATION
+*/
+
+struct ImLinePlotBucket {
+    float Min;
+    float Max;
+    float Mean;     // NaN when the source doesn't keep it
+};
+
+// Min, max and mean of v[0, n), n > 0
+static ImLinePlotBucket ComputeBucket(const float* v, int n) {
+    int i = 0;
+    float min_v = v[0], max_v = v[0];
+    double sum = 0.0;
+#if defined(__AVX2__)
+    if (n >= 8) {
+        __m256 min8 = _mm256_loadu_ps(v), max8 = min8, sum8 = min8;
+        for (i = 8; i + 8 <= n; i += 8) {
+            __m256 x = _mm256_loadu_ps(v + i);
+            min8 = _mm256_min_ps(min8, x);
+            max8 = _mm256_max_ps(max8, x);
+            sum8 = _mm256_add_ps(sum8, x);
+        }
+        alignas(32) float mins[8], maxs[8], sums[8];
+        _mm256_store_ps(mins, min8);
+        _mm256_store_ps(maxs, max8);
+        _mm256_store_ps(sums, sum8);
+        for (int k = 0; k < 8; k++) {
+            min_v = ImMin(min_v, mins[k]);
+            max_v = ImMax(max_v, maxs[k]);
+            sum += sums[k];
+        }
+    }
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    if (i + 4 <= n) {
+        __m128 min4 = _mm_loadu_ps(v + i), max4 = min4, sum4 = min4;
+        for (i += 4; i + 4 <= n; i += 4) {
+            __m128 x = _mm_loadu_ps(v + i);
+            min4 = _mm_min_ps(min4, x);
+            max4 = _mm_max_ps(max4, x);
+            sum4 = _mm_add_ps(sum4, x);
+        }
+        alignas(16) float mins[4], maxs[4], sums[4];
+        _mm_store_ps(mins, min4);
+        _mm_store_ps(maxs, max4);
+        _mm_store_ps(sums, sum4);
+        for (int k = 0; k < 4; k++) {
+            min_v = ImMin(min_v, mins[k]);
+            max_v = ImMax(max_v, maxs[k]);
+            sum += sums[k];
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        min_v = ImMin(min_v, v[i]);
+        max_v = ImMax(max_v, v[i]);
+        sum += v[i];
+    }
+    return { min_v, max_v, (float)(sum / n) };
+}
+
+// Combines adjacent buckets holding count_a and count_b samples
+static ImLinePlotBucket MergeBuckets(const ImLinePlotBucket& a, ImU64 count_a, const ImLinePlotBucket& b, ImU64 count_b) {
+    return { ImMin(a.Min, b.Min), ImMax(a.Max, b.Max), (float)(((double)a.Mean * count_a + (double)b.Mean * count_b) / (double)(count_a + count_b)) };
+}
+
+/*
+    TIME SERIES
+*/
+
+ImTimeSeries::ImTimeSeries(int capacity) {
+    // A quarter of the capacity is kept as headroom the producer can write into while the consumer reads the rest
+    Capacity = ImMax(capacity, 64);
+    int storage = 1;
+    while (storage < Capacity + Capacity / 4)
+        storage <<= 1;
+    Mask = storage - 1;
+    Data = (float*)IM_ALLOC(sizeof(float) * storage);
+
+    // Level l holds storage >> l buckets of 1 << l samples, the coarsest still spans 16 buckets so none of the
+    // buckets covering the readable samples is overwritten before them
+    MaxLevel = 0;
+    while ((16 << MaxLevel) < storage)
+        MaxLevel++;
+    MaxLevel = ImMax(MaxLevel, MinLevel);
+    int pyramid_size = 0;
+    for (int level = MinLevel; level <= MaxLevel; level++) {
+        LevelOffsets[level] = pyramid_size;
+        pyramid_size += storage >> level;
+    }
+    Pyramid = (ImVec2*)IM_ALLOC(sizeof(ImVec2) * ImMax(pyramid_size, 1));
+}
+
+ImTimeSeries::~ImTimeSeries() {
+    IM_FREE(Data);
+    IM_FREE(Pyramid);
+}
+
+void ImTimeSeries::CompleteBucket(int level, ImU64 bucket, ImVec2 min_max) {
+    for (;;) {
+        Pyramid[LevelOffsets[level] + (int)(bucket & (ImU64)(Mask >> level))] = min_max;
+        if (level == MaxLevel)
+            return;
+        // Fold into the parent bucket, which completes with its second child
+        level++;
+        if (!(bucket & 1)) {
+            Pending[level] = min_max;
+            return;
+        }
+        min_max = ImVec2(ImMin(Pending[level].x, min_max.x), ImMax(Pending[level].y, min_max.y));
+        bucket >>= 1;
+    }
+}
+
+void ImTimeSeries::Write(ImU64 index, float value) {
+    const ImU64 block = (1 << MinLevel) - 1;
+    Data[index & Mask] = value;
+    ImVec2& pending = Pending[MinLevel];
+    pending = (index & block) == 0 ? ImVec2(value, value) : ImVec2(ImMin(pending.x, value), ImMax(pending.y, value));
+    if ((index & block) == block)
+        CompleteBucket(MinLevel, index >> MinLevel, pending);
+}
+
+void ImTimeSeries::Push(float value) {
+    ImU64 size = Head.load(std::memory_order_relaxed);
+    Write(size, value);
+    Head.store(size + 1, std::memory_order_release);
+}
+
+void ImTimeSeries::Push(const float* values, int count) {
+    const int block = 1 << MinLevel;
+    ImU64 size = Head.load(std::memory_order_relaxed);
+    int i = 0;
+    for (; i < count && (size & (block - 1)); i++, size++)
+        Write(size, values[i]);
+    // Whole blocks never wrap since the storage is a multiple of the block size
+    for (; i + block <= count; i += block, size += block) {
+        memcpy(Data + (size & Mask), values + i, sizeof(float) * block);
+        ImLinePlotBucket b = ComputeBucket(values + i, block);
+        CompleteBucket(MinLevel, size >> MinLevel, ImVec2(b.Min, b.Max));
+    }
+    for (; i < count; i++, size++)
+        Write(size, values[i]);
+    Head.store(size, std::memory_order_release);
+}
+
+ImU64 ImTimeSeries::Size() const {
+    return Head.load(std::memory_order_acquire);
+}
+
+int ImTimeSeries::Count() const {
+    return (int)ImMin(Size(), (ImU64)Capacity);
+}
+
+int ImTimeSeries::GetSpans(ImU64 first, ImU64 last, const float** out_spans, int* out_counts) const {
+    if (first >= last)
+        return 0;
+    const ImU64 begin = first & Mask;
+    const ImU64 count = last - first;
+    out_spans[0] = Data + begin;
+    out_counts[0] = (int)ImMin(count, (ImU64)Mask + 1 - begin);
+    if ((ImU64)out_counts[0] == count)
+        return 1;
+    out_spans[1] = Data;
+    out_counts[1] = (int)(count - out_counts[0]);
+    return 2;
+}
+
+ImVec2 ImTimeSeries::GetBucket(int level, ImU64 bucket, ImU64 size) const {
+    const ImU64 first = bucket << level;
+    const ImU64 last = ImMin((bucket + 1) << level, size);
+    if (level < MinLevel) {
+        ImLinePlotBucket b = ComputeBucket(Data + (first & Mask), (int)(last - first));
+        return ImVec2(b.Min, b.Max);
+    }
+    if (level > MaxLevel || last < (bucket + 1) << level) {
+        // Partial (or coarser than stored) bucket: combine its children, at most one of which is partial again
+        ImVec2 min_max = GetBucket(level - 1, bucket << 1, size);
+        for (ImU64 child = (bucket << 1) + 1; child < ((bucket + 1) << 1) && child << (level - 1) < last; child++) {
+            ImVec2 c = GetBucket(level - 1, child, size);
+            min_max = ImVec2(ImMin(min_max.x, c.x), ImMax(min_max.y, c.y));
+        }
+        return min_max;
+    }
+    return Pyramid[LevelOffsets[level] + (int)(bucket & (ImU64)(Mask >> level))];
+}
+
+bool ImTimeSeries::GetMinMax(ImU64 first, ImU64 last, float* out_min, float* out_max) const {
+    const ImU64 size = Size();
+    first = ImMax(first, size > (ImU64)Capacity ? size - Capacity : 0);
+    last = ImMin(last, size);
+    if (first >= last)
+        return false;
+    // Largest aligned buckets first: O(log(last - first)) lookups
+    ImVec2 min_max(FLT_MAX, -FLT_MAX);
+    while (first < last) {
+        int level = 0;
+        while (level < MaxLevel && !(first & ((ImU64)1 << level)) && first + ((ImU64)2 << level) <= last)
+            level++;
+        ImVec2 b = GetBucket(level, first >> level, size);
+        min_max = ImVec2(ImMin(min_max.x, b.x), ImMax(min_max.y, b.y));
+        first += (ImU64)1 << level;
+    }
+    *out_min = min_max.x;
+    *out_max = min_max.y;
+    return true;
+}
+
+/*
+    LINE PLOT
+*/
+
+struct ImLinePlotState {
+    // View in sample indices, following the whole series until the user zooms or pans
+    bool    Fit = true;
+    double  ViewMin = 0.0;
+    double  ViewMax = 0.0;
+
+    // Buckets[i] covers samples [(First + i) << Level, (First + i + 1) << Level)
+    std::vector<ImLinePlotBucket> Buckets;
+    std::vector<ImLinePlotBucket> BucketsNext;
+    int     Level = -1;
+    ImS64   First = 0;
+
+    // Array decimation cache
+    int     Samples = 0;        // values_count the cache was built from
+    int     Version = 0;
+
+    // Fills Buckets for [first, last) at 'level', reusing what is cached: same level buckets are copied and coarser
+    // levels are merged from finer ones, only buckets that were partial or never covered read the samples again.
+    void Decimate(const float* values, int values_count, int values_version, int level, int first, int last) {
+        if (Level < 0 || level < Level || values_version != Version || values_count < Samples) {
+            Buckets.clear();
+            Level = level;
+            First = 0;
+            Samples = 0;
+            Version = values_version;
+        }
+        if (level == Level && first == First && last == First + (int)Buckets.size() && values_count == Samples)
+            return;
+
+        const int shift = level - Level;
+        const int cached_first = (int)First;
+        const int complete_end = ImMin(cached_first + (int)Buckets.size(), Samples >> Level);
+        BucketsNext.resize(last - first);
+        for (int i = first; i < last; i++) {
+            const int lo = i << shift, hi = (i + 1) << shift;
+            ImLinePlotBucket& b = BucketsNext[i - first];
+            if (lo >= cached_first && hi <= complete_end) {
+                b = Buckets[lo - cached_first];
+                for (int j = lo + 1; j < hi; j++)
+                    b = MergeBuckets(b, j - lo, Buckets[j - cached_first], 1);
+            }
+            else {
+                const int begin = i << level;
+                b = ComputeBucket(values + begin, ImMin(values_count, (i + 1) << level) - begin);
+            }
+        }
+        Buckets.swap(BucketsNext);
+        Level = level;
+        First = first;
+        Samples = values_count;
+    }
+};
+
+// Frame, interaction and drawing shared by the LinePlot overloads. Samples [sample_begin, sample_end) are plottable,
+// decimate(level, first, last) must leave the buckets [first, last) of 1 << level samples in st.Buckets.
+template<typename DecimateFn>
+static void LinePlotEx(ImLinePlotState& st, ImS64 sample_begin, ImS64 sample_end, int max_level, ImLinePlotFlags flags, DecimateFn decimate, const char* overlay = nullptr) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImVec2 size = ImGui::CalcItemSize(style.ImLinePlotSize, ImGui::CalcItemWidth(), ImGui::GetTextLineHeight() * 8.0f);
+    ImGui::InvisibleButton("##plot", size);
+    const ImRect frame(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    const bool hovered = ImGui::IsItemHovered();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(frame.Min, frame.Max, ImWidgets::GetColorU32(ImWidgetsCol_LinePlotBg), ImGui::GetStyle().FrameRounding);
+
+    const double first_sample = (double)sample_begin;
+    const double last_sample = (double)ImMax(sample_end - 1, sample_begin + 1);
+    if (st.Fit) {
+        st.ViewMin = first_sample;
+        st.ViewMax = last_sample;
+    }
+
+    // Wheel zooms around the mouse, dragging pans, double-click fits the whole series again
+    if (!(flags & ImLinePlotFlags_NoInteraction)) {
+        ImGuiIO& io = ImGui::GetIO();
+        const double samples_per_pixel = (st.ViewMax - st.ViewMin) / size.x;
+        if (hovered) {
+            ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
+            if (io.MouseWheel != 0.0f) {
+                double anchor = st.ViewMin + (io.MousePos.x - frame.Min.x) * samples_per_pixel;
+                double scale = io.MouseWheel > 0.0f ? 0.8 : 1.25;
+                st.ViewMin = anchor - (anchor - st.ViewMin) * scale;
+                st.ViewMax = anchor + (st.ViewMax - anchor) * scale;
+                st.Fit = false;
+            }
+            if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+                st.Fit = true;
+        }
+        if (ImGui::IsItemActive() && io.MouseDelta.x != 0.0f) {
+            st.ViewMin -= io.MouseDelta.x * samples_per_pixel;
+            st.ViewMax -= io.MouseDelta.x * samples_per_pixel;
+            st.Fit = false;
+        }
+    }
+    if (st.Fit) {
+        st.ViewMin = first_sample;
+        st.ViewMax = last_sample;
+    }
+    else {
+        double span = ImClamp(st.ViewMax - st.ViewMin, ImMin(4.0, last_sample - first_sample), last_sample - first_sample);
+        st.ViewMin = ImClamp(st.ViewMin, first_sample, last_sample - span);
+        st.ViewMax = st.ViewMin + span;
+    }
+
+    if (overlay) {
+        ImVec2 overlay_size = ImGui::CalcTextSize(overlay);
+        draw_list->AddText(ImVec2(frame.Max.x - overlay_size.x - ImGui::GetStyle().FramePadding.x, frame.Min.y + ImGui::GetStyle().FramePadding.y), ImGui::GetColorU32(ImGuiCol_Text), overlay);
+    }
+    if (sample_end <= sample_begin || size.x <= 0.0f)
+        return;
+
+    // Smallest power-of-two bucket holding at least a pixel column worth of samples: at most one bucket per pixel
+    const ImVec2 padding = ImGui::GetStyle().FramePadding;
+    const ImRect inner(frame.Min.x + padding.x, frame.Min.y + padding.y, frame.Max.x - padding.x, frame.Max.y - padding.y);
+    const double view_span = st.ViewMax - st.ViewMin;
+    int level = 0;
+    while (level < max_level && (double)((ImS64)1 << level) * inner.GetWidth() < view_span)
+        level++;
+    const ImS64 bucket_size = (ImS64)1 << level;
+    const ImS64 bucket_begin = sample_begin / bucket_size;
+    const ImS64 bucket_end = (sample_end - 1) / bucket_size + 1;
+    const ImS64 first = ImClamp((ImS64)st.ViewMin / bucket_size, bucket_begin, bucket_end - 1);
+    const ImS64 last = ImClamp((ImS64)st.ViewMax / bucket_size + 2, first + 1, bucket_end);
+    decimate(level, first, last);
+
+    float y_min = FLT_MAX, y_max = -FLT_MAX;
+    for (const ImLinePlotBucket& b : st.Buckets) {
+        y_min = ImMin(y_min, b.Min);
+        y_max = ImMax(y_max, b.Max);
+    }
+    if (y_max - y_min < 1e-6f) {
+        y_min -= 0.5f;
+        y_max += 0.5f;
+    }
+
+    const double x_scale = (inner.Max.x - inner.Min.x) / view_span;
+    const float y_scale = (inner.Max.y - inner.Min.y) / (y_max - y_min);
+    const double bucket_center = (bucket_size - 1) * 0.5;
+
+    // One point per bucket at full resolution, otherwise a min and a max point per pixel column
+    const int points_count = (int)(level == 0 ? st.Buckets.size() : st.Buckets.size() * 2);
+    ImVec2* points = FrameAllocArray<ImVec2>(points_count);
+    ImVec2* out = points;
+    for (int i = 0; i < (int)st.Buckets.size(); i++) {
+        const ImLinePlotBucket& b = st.Buckets[i];
+        float x = (float)(inner.Min.x + ((double)(st.First + i) * bucket_size + bucket_center - st.ViewMin) * x_scale);
+        *out++ = ImVec2(x, inner.Max.y - (b.Min - y_min) * y_scale);
+        if (level != 0)
+            *out++ = ImVec2(x, inner.Max.y - (b.Max - y_min) * y_scale);
+    }
+
+    draw_list->PushClipRect(frame.Min, frame.Max, true);
+    draw_list->AddPolyline(points, points_count, ImWidgets::GetColorU32(ImWidgetsCol_LinePlotLine), ImDrawFlags_None, style.ImLinePlotThickness);
+
+    if (!(flags & ImLinePlotFlags_NoLabels)) {
+        char buf[32];
+        const ImU32 col_text = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+        snprintf(buf, sizeof(buf), "%g", y_max);
+        draw_list->AddText(inner.Min, col_text, buf);
+        snprintf(buf, sizeof(buf), "%g", y_min);
+        draw_list->AddText(ImVec2(inner.Min.x, inner.Max.y - ImGui::GetTextLineHeight()), col_text, buf);
+    }
+    draw_list->PopClipRect();
+
+    if (hovered && !(flags & ImLinePlotFlags_NoTooltip) && inner.Contains(ImGui::GetIO().MousePos)) {
+        const float mouse_x = ImGui::GetIO().MousePos.x;
+        const double sample = st.ViewMin + (mouse_x - inner.Min.x) / x_scale;
+        const int bucket = (int)ImClamp((ImS64)((sample + 0.5) / bucket_size) - st.First, (ImS64)0, (ImS64)st.Buckets.size() - 1);
+        const ImLinePlotBucket& b = st.Buckets[bucket];
+        const ImS64 begin = (st.First + bucket) * bucket_size;
+        draw_list->AddLine(ImVec2(mouse_x, inner.Min.y), ImVec2(mouse_x, inner.Max.y), ImGui::GetColorU32(ImGuiCol_TextDisabled));
+        if (level == 0)
+            ImGui::SetTooltip("[%lld] %g", (long long)begin, b.Min);
+        else if (b.Mean != b.Mean)
+            ImGui::SetTooltip("[%lld, %lld] min %g, max %g", (long long)begin, (long long)ImMin(begin + bucket_size, sample_end) - 1, b.Min, b.Max);
+        else
+            ImGui::SetTooltip("[%lld, %lld] min %g, max %g, mean %g", (long long)begin, (long long)ImMin(begin + bucket_size, sample_end) - 1, b.Min, b.Max, b.Mean);
+    }
+}
+
+void ImWidgets::LinePlot(const char* label, const float* values, int values_count, int values_version, ImLinePlotFlags flags) {
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, ImLinePlotState>& linePlotStates = GetStatePool<ImLinePlotState>(ImWidgetsContextSlot_LinePlot);
+    ImLinePlotState& st = linePlotStates[id];
+
+    ImGui::PushID(label);
+    LinePlotEx(st, 0, values_count, 30, flags, [&](int level, ImS64 first, ImS64 last) {
+        st.Decimate(values, values_count, values_version, level, (int)first, (int)last);
+    });
+    ImGui::PopID();
+}
+
+void ImWidgets::LinePlot(const char* label, const ImTimeSeries& series, ImLinePlotFlags flags) {
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, ImLinePlotState>& timeSeriesPlotStates = GetStatePool<ImLinePlotState>(ImWidgetsContextSlot_TimeSeriesPlot);
+    ImLinePlotState& st = timeSeriesPlotStates[id];
+
+    // Buckets come straight from the series' pyramid, nothing is cached here
+    const ImU64 size = series.Size();
+    const ImU64 begin = size > (ImU64)series.Capacity ? size - series.Capacity : 0;
+    ImGui::PushID(label);
+    LinePlotEx(st, (ImS64)begin, (ImS64)size, 62, flags, [&](int level, ImS64 first, ImS64 last) {
+        st.Buckets.resize((size_t)(last - first));
+        for (ImS64 i = first; i < last; i++) {
+            // The oldest bucket may straddle samples that were already dropped
+            ImU64 bucket_first = ImMax((ImU64)i << level, begin);
+            ImVec2 min_max;
+            if (bucket_first == (ImU64)i << level)
+                min_max = series.GetBucket(level, (ImU64)i, size);
+            else
+                series.GetMinMax(bucket_first, ImMin((ImU64)(i + 1) << level, size), &min_max.x, &min_max.y);
+            st.Buckets[i - first] = { min_max.x, min_max.y, NAN };
+        }
+        st.Level = level;
+        st.First = first;
+    });
+    ImGui::PopID();
+}
+
+/*
+    LOD PYRAMID
+*/
+
+// Buckets of 32 samples and coarser are stored, finer ones read the samples
+static const int ImLodMinLevel = 5;
+// Stored nodes up to this level are built by workers over aligned blocks of leaves, coarser ones span blocks
+static const int ImLodBlockLevel = 16;
+
+// Pyramid over 'leaves' of 1 << ImLodMinLevel samples, stored in-order: node (k, b) covering leaves
+// [b << k, (b + 1) << k) lives at ((2b + 1) << k) - 1. Complete nodes of the first M leaves all sit below 2M,
+// so appending samples only ever appends records and nothing is moved or re-laid out.
+struct ImLodPyramidState {
+    ImLinePlotState     Plot;
+    std::string         Path;
+    ImFileMapping       File;
+    std::vector<ImLinePlotBucket> Memory;
+    ImLinePlotBucket*   Records = nullptr;
+    ImU64               RecordsCapacity = 0;
+    std::shared_mutex   RecordsMutex;       // Exclusive while growing the storage, shared while the UI reads it
+
+    const float*        Values = nullptr;
+    std::atomic<ImU64>  TargetCount{ 0 };   // Samples to cover, raised on append while building
+    std::atomic<ImU64>  Leaves{ 0 };        // Leaves whose nodes are complete and readable
+    int                 Version = 0;
+    ImWidgetsTaskRef    Builder;
+    std::atomic<bool>   Cancel{ false };
+    std::atomic<bool>   Failed{ false };
+
+    ~ImLodPyramidState() { StopBuild(); }
+
+    static ImU64 NodeIndex(int k, ImU64 b) { return (((b << 1) + 1) << k) - 1; }
+
+    bool IsBuilding() const { return Builder && !Builder->Finished(); }
+
+    void StopBuild() {
+        Cancel = true;
+        WaitTask(Builder);
+        Builder.reset();
+        Cancel = false;
+    }
+
+    void Reset(const float* values, int version) {
+        StopBuild();
+        Values = values;
+        Version = version;
+        Leaves = 0;
+        Failed = false;
+        Memory.clear();
+        Records = nullptr;
+        RecordsCapacity = 0;
+        if (!Path.empty())
+            Failed = !File.Open(Path.c_str(), true);
+    }
+
+    bool Reserve(ImU64 records) {
+        if (records <= RecordsCapacity)
+            return true;
+        records = ImMax(records, RecordsCapacity + RecordsCapacity / 2);
+        if (!Path.empty()) {
+            std::unique_lock<std::shared_mutex> lock(RecordsMutex);
+            if (!File.Resize(records * sizeof(ImLinePlotBucket)))
+                return false;
+            Records = (ImLinePlotBucket*)File.Data;
+        }
+        else {
+            // Only this thread writes records, so they can be copied before taking the lock for the swap alone
+            std::vector<ImLinePlotBucket> memory((size_t)records);
+            std::copy(Memory.begin(), Memory.end(), memory.begin());
+            std::unique_lock<std::shared_mutex> lock(RecordsMutex);
+            Memory.swap(memory);
+            Records = Memory.data();
+        }
+        RecordsCapacity = records;
+        return true;
+    }
+
+    // Stores node (k, b) and its ancestors completed by it, up to level 'max_k'
+    void CompleteNode(int k, ImU64 b, ImLinePlotBucket node, int max_k) {
+        Records[NodeIndex(k, b)] = node;
+        for (; (b & 1) && k < max_k; k++, b >>= 1) {
+            node = MergeBuckets(Records[NodeIndex(k, b - 1)], 1, node, 1);
+            Records[NodeIndex(k + 1, b >> 1)] = node;
+        }
+    }
+
+    // Builder task: extends the pyramid until it covers TargetCount, in passes so appends made meanwhile are picked up
+    void BuildMain() {
+        const int workers_count = TaskPoolThreads();
+        for (;;) {
+            const ImU64 first_leaf = Leaves.load();
+            const ImU64 last_leaf = TargetCount.load() >> ImLodMinLevel;
+            if (first_leaf >= last_leaf || Cancel)
+                break;
+            if (!Reserve(last_leaf * 2)) {
+                Failed = true;
+                break;
+            }
+
+            // Workers take aligned blocks of leaves so that the nodes they complete never reach outside their block
+            const ImU64 block = (ImU64)1 << ImLodBlockLevel;
+            const ImU64 first_block = first_leaf / block, last_block = (last_leaf - 1) / block + 1;
+            std::atomic<ImU64> next_block{ first_block };
+            auto work = [&]() {
+                for (ImU64 bi; !Cancel && (bi = next_block++) < last_block; ) {
+                    const ImU64 end = ImMin((bi + 1) * block, last_leaf);
+                    for (ImU64 leaf = ImMax(bi * block, first_leaf); leaf < end; leaf++)
+                        CompleteNode(0, leaf, ComputeBucket(Values + (leaf << ImLodMinLevel), 1 << ImLodMinLevel), ImLodBlockLevel);
+                }
+            };
+            ParallelFor((int)ImMin((ImU64)workers_count, last_block - first_block), [&](int) { work(); });
+            if (Cancel)
+                break;
+
+            // Nodes above the block level, from each block completed in this pass
+            for (ImU64 bi = first_leaf / block; bi < last_leaf / block; bi++)
+                if ((bi + 1) * block > first_leaf)
+                    CompleteNode(ImLodBlockLevel, bi, Records[NodeIndex(ImLodBlockLevel, bi)], 63);
+            Leaves.store(last_leaf);
+        }
+    }
+
+    // Also resumes a build cancelled while the plot was out of sight, from the leaves completed so far
+    void StartBuild(ImGuiID owner) {
+        Cancel = false;
+        Builder = SubmitTask(owner, &Cancel, [this]() { BuildMain(); });
+    }
+
+    // Min/max/mean of samples [bucket << level, (bucket + 1) << level) among the first 'count', where every leaf
+    // fully inside that range is built. Partial nodes are combined from their children, at most one of which is partial.
+    ImLinePlotBucket GetBucket(int level, ImU64 bucket, ImU64 count, ImU64 leaves) const {
+        const ImU64 first = bucket << level;
+        const ImU64 last = ImMin((bucket + 1) << level, count);
+        if (level < ImLodMinLevel)
+            return ComputeBucket(Values + first, (int)(last - first));
+        const int k = level - ImLodMinLevel;
+        if (((bucket + 1) << k) <= leaves)
+            return Records[NodeIndex(k, bucket)];
+        ImLinePlotBucket left = GetBucket(level - 1, bucket << 1, count, leaves);
+        const ImU64 middle = ((bucket << 1) + 1) << (level - 1);
+        if (middle >= last)
+            return left;
+        return MergeBuckets(left, middle - first, GetBucket(level - 1, (bucket << 1) + 1, count, leaves), last - middle);
+    }
+};
+
+void ImWidgets::LinePlotLod(const char* label, const float* values, ImU64 values_count, int values_version, const char* lod_path, ImLinePlotFlags flags) {
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, std::unique_ptr<ImLodPyramidState>>& lodStates = GetStatePool<std::unique_ptr<ImLodPyramidState>>(ImWidgetsContextSlot_LinePlotLod);
+    std::unique_ptr<ImLodPyramidState>& st_ptr = lodStates[id];
+    if (!st_ptr)
+        st_ptr.reset(new ImLodPyramidState());
+    ImLodPyramidState& st = *st_ptr;
+
+    const char* path = lod_path ? lod_path : "";
+    if (st.Values == nullptr || st.Version != values_version || st.Path != path || values_count < st.TargetCount) {
+        st.Path = path;
+        st.Reset(values, values_version);
+    }
+    else if (st.Values != values) {
+        // Same samples in a new buffer, resume from there
+        st.StopBuild();
+        st.Values = values;
+    }
+    st.TargetCount = values_count;
+    KeepTaskOwnerAlive(id);
+    if (!st.IsBuilding() && !st.Failed && st.Leaves < values_count >> ImLodMinLevel)
+        st.StartBuild(id);
+
+    // Only what is built is plotted, the last partial leaf is read from the samples once everything else is
+    const ImU64 leaves = st.Leaves.load();
+    const bool built = !st.IsBuilding() && leaves == values_count >> ImLodMinLevel;
+    const ImU64 plotted = built ? values_count : leaves << ImLodMinLevel;
+
+    char overlay[64];
+    if (st.Failed)
+        snprintf(overlay, sizeof(overlay), "Unable to write '%s'", path);
+    else if (!built)
+        snprintf(overlay, sizeof(overlay), "Building LOD %.0f%%", values_count ? 100.0 * (double)plotted / (double)values_count : 0.0);
+
+    ImGui::PushID(label);
+    LinePlotEx(st.Plot, 0, (ImS64)plotted, 62, flags, [&](int level, ImS64 first, ImS64 last) {
+        // Held only while copying the buckets out, drawing works on the copy
+        st.Plot.Buckets.resize((size_t)(last - first));
+        std::shared_lock<std::shared_mutex> lock(st.RecordsMutex);
+        for (ImS64 i = first; i < last; i++)
+            st.Plot.Buckets[i - first] = st.GetBucket(level, (ImU64)i, plotted, leaves);
+        st.Plot.Level = level;
+        st.Plot.First = first;
+    }, (st.Failed || !built) ? overlay : nullptr);
+    ImGui::PopID();
+}
+
+/*
+    HISTOGRAM
+*/
+
+// Counts v[0, n) into bins of width 1 / scale starting at range_min. counts has bins_count + 2 slots:
+// counts[1 + bin] for values in range, counts[0] and counts[bins_count + 1] collect those below and above (and NaNs).
+static void BinValues(const float* v, int n, float range_min, float scale, int bins_count, int* counts) {
+    // Four interleaved sub-histograms so that runs of equal bins don't serialize on one counter
+    const int stride = bins_count + 2;
+    std::vector<int> sub(stride * 4, 0);
+    int* c0 = sub.data();
+    int* c1 = c0 + stride;
+    int* c2 = c1 + stride;
+    int* c3 = c2 + stride;
+    const float last_slot = (float)(bins_count + 1);
+    int i = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 min4 = _mm_set1_ps(range_min), scale4 = _mm_set1_ps(scale), one4 = _mm_set1_ps(1.0f);
+    const __m128 zero4 = _mm_setzero_ps(), last4 = _mm_set1_ps(last_slot);
+    alignas(16) int slots[4];
+    for (; i + 4 <= n; i += 4) {
+        __m128 t = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(v + i), min4), scale4), one4);
+        t = _mm_min_ps(_mm_max_ps(t, zero4), last4);    // max_ps returns its second operand for NaN
+        _mm_store_si128((__m128i*)slots, _mm_cvttps_epi32(t));
+        c0[slots[0]]++;
+        c1[slots[1]]++;
+        c2[slots[2]]++;
+        c3[slots[3]]++;
+    }
+#endif
+    for (; i < n; i++) {
+        float t = (v[i] - range_min) * scale + 1.0f;
+        c0[t >= 0.0f ? (int)ImMin(t, last_slot) : 0]++;
+    }
+    for (int b = 0; b < stride; b++)
+        counts[b] += c0[b] + c1[b] + c2[b] + c3[b];
+}
+
+// Splits large inputs across the pool, each part with its own counts
+static void ParallelBinValues(const float* v, int n, float range_min, float scale, int bins_count, int* counts) {
+    const int min_part_size = 1 << 20;
+    const int parts = ImMin(TaskPoolThreads(), ImMax(n / min_part_size, 1));
+    if (parts == 1) {
+        BinValues(v, n, range_min, scale, bins_count, counts);
+        return;
+    }
+    std::vector<std::vector<int>> part_counts(parts, std::vector<int>(bins_count + 2, 0));
+    ParallelFor(parts, [&](int p) {
+        int begin = (int)((ImS64)n * p / parts), end = (int)((ImS64)n * (p + 1) / parts);
+        BinValues(v + begin, end - begin, range_min, scale, bins_count, part_counts[p].data());
+    });
+    for (const std::vector<int>& c : part_counts)
+        for (int b = 0; b < bins_count + 2; b++)
+            counts[b] += c[b];
+}
+
+// Bin counts for (Version, RangeMin, RangeMax, BinsCount) over the first Samples values
+struct ImHistogramBins {
+    std::vector<int> Counts;
+    int     Version = 0;
+    int     Samples = 0;
+    int     BinsCount = 0;
+    float   RangeMin = 0.0f;
+    float   RangeMax = 0.0f;
+    bool    AutoRange = false;
+    float   DataMin = FLT_MAX;      // Auto range: extent of the first Samples values
+    float   DataMax = -FLT_MAX;
+    int     MaxCount = 0;
+
+    // The counts cover a prefix of values for these inputs, samples appended since can be binned on their own
+    bool CanAppend(int values_count, int values_version, int bins_count, float range_min, float range_max) const {
+        const bool auto_range = !(range_min < range_max);
+        return values_version == Version && values_count >= Samples && bins_count == BinsCount && auto_range == AutoRange &&
+            (auto_range || (range_min == RangeMin && range_max == RangeMax));
+    }
+
+    bool UpToDate(int values_count, int values_version, int bins_count, float range_min, float range_max) const {
+        return values_count == Samples && CanAppend(values_count, values_version, bins_count, range_min, range_max);
+    }
+
+    // Update() only bins fewer than max_samples appended values, without moving an automatic range
+    bool QuickUpdate(const float* values, int values_count, int values_version, int bins_count, float range_min, float range_max, int max_samples) const {
+        if (!CanAppend(values_count, values_version, bins_count, range_min, range_max) || values_count - Samples >= max_samples)
+            return false;
+        if (!AutoRange || values_count == Samples)
+            return true;
+        ImLinePlotBucket b = ComputeBucket(values + Samples, values_count - Samples);
+        return b.Min >= RangeMin && b.Max < RangeMax;
+    }
+
+    void Update(const float* values, int values_count, int values_version, int bins_count, float range_min, float range_max) {
+        const bool auto_range = !(range_min < range_max);
+        const bool appended = CanAppend(values_count, values_version, bins_count, range_min, range_max);
+        if (appended && values_count == Samples)
+            return;
+        int first = appended ? Samples : 0;
+        if (auto_range) {
+            if (!appended) {
+                DataMin = FLT_MAX;
+                DataMax = -FLT_MAX;
+            }
+            if (values_count > first) {
+                ImLinePlotBucket b = ComputeBucket(values + first, values_count - first);
+                DataMin = ImMin(DataMin, b.Min);
+                DataMax = ImMax(DataMax, b.Max);
+            }
+            // New samples outside the bins built so far move every bin edge
+            if (!appended || DataMin < RangeMin || DataMax >= RangeMax) {
+                first = 0;
+                range_min = DataMin <= DataMax ? DataMin : 0.0f;
+                range_max = DataMin <= DataMax ? DataMax : 1.0f;
+                // Half-open bins, widen by a little so the largest value falls in the last bin
+                range_max = range_max > range_min ? range_max + (range_max - range_min) * 1e-6f : range_min + 1.0f;
+            }
+            else {
+                range_min = RangeMin;
+                range_max = RangeMax;
+            }
+        }
+        if (first == 0)
+            Counts.assign(bins_count + 2, 0);
+        ParallelBinValues(values + first, values_count - first, range_min, bins_count / (range_max - range_min), bins_count, Counts.data());
+        MaxCount = 0;
+        for (int b = 1; b <= bins_count; b++)
+            MaxCount = ImMax(MaxCount, Counts[b]);
+        Version = values_version;
+        Samples = values_count;
+        BinsCount = bins_count;
+        RangeMin = range_min;
+        RangeMax = range_max;
+        AutoRange = auto_range;
+    }
+};
+
+struct ImHistogramBinJob : ImWidgetsJob {
+    ImHistogramBins     Bins;
+    int                 ValuesCount = 0;
+    int                 ValuesVersion = 0;
+    int                 BinsCount = 0;
+    float               RangeMin = 0.0f;
+    float               RangeMax = 0.0f;
+
+    // Still worth finishing for these inputs: they only appended values since it started
+    bool Covers(int values_count, int values_version, int bins_count, float range_min, float range_max) const {
+        return values_count >= ValuesCount && values_version == ValuesVersion && bins_count == BinsCount && range_min == RangeMin && range_max == RangeMax;
+    }
+};
+
+struct ImHistogramState {
+    static const int    InlineMaxSamples = 1 << 16;    // Fewer appended values are binned on the UI thread right away
+
+    ImHistogramBins     Bins;           // Drawn, the last completed binning
+    ImWidgetsJobPtr<ImHistogramBinJob> Job;
+    std::vector<float>  Columns;        // Reused per frame: tallest bin of each drawn column
+
+    void StartBinning(ImGuiID owner, const float* values, int values_count, int values_version, int bins_count, float range_min, float range_max) {
+        Job.reset(new ImHistogramBinJob());
+        ImHistogramBinJob* job = Job.get();
+        job->Bins = Bins;   // Appended values are binned on top of the current counts
+        job->ValuesCount = values_count;
+        job->ValuesVersion = values_version;
+        job->BinsCount = bins_count;
+        job->RangeMin = range_min;
+        job->RangeMax = range_max;
+        job->Start(owner, [job, values]() {
+            job->Bins.Update(values, job->ValuesCount, job->ValuesVersion, job->BinsCount, job->RangeMin, job->RangeMax);
+        });
+    }
+};
+
+void ImWidgets::Histogram(const char* label, const float* values, int values_count, int bins_count, float range_min, float range_max, int values_version, ImHistogramFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, ImHistogramState>& histogramStates = GetStatePool<ImHistogramState>(ImWidgetsContextSlot_Histogram);
+    ImHistogramState& st = histogramStates[id];
+    bins_count = ImMax(bins_count, 1);
+    values_count = ImMax(values_count, 0);
+
+    // Small appends are binned right away, anything bigger on the task pool while the previous counts are drawn
+    const bool job_stale = st.Job && !st.Job->Covers(values_count, values_version, bins_count, range_min, range_max);
+    if (JobOutdated(id, st.Job.get(), job_stale))
+        st.Job.reset();
+    if (st.Job && st.Job->Done) {
+        st.Bins = std::move(st.Job->Bins);
+        st.Job.reset();
+    }
+    if (!st.Job && !st.Bins.UpToDate(values_count, values_version, bins_count, range_min, range_max)) {
+        if (st.Bins.QuickUpdate(values, values_count, values_version, bins_count, range_min, range_max, ImHistogramState::InlineMaxSamples))
+            st.Bins.Update(values, values_count, values_version, bins_count, range_min, range_max);
+        else
+            st.StartBinning(id, values, values_count, values_version, bins_count, range_min, range_max);
+    }
+    const ImHistogramBins& bins = st.Bins;
+
+    ImGui::PushID(label);
+    ImVec2 size = ImGui::CalcItemSize(style.ImHistogramSize, ImGui::CalcItemWidth(), ImGui::GetTextLineHeight() * 8.0f);
+    ImGui::InvisibleButton("##histogram", size);
+    const ImRect frame(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    const ImVec2 padding = ImGui::GetStyle().FramePadding;
+    const ImRect inner(frame.Min.x + padding.x, frame.Min.y + padding.y, frame.Max.x - padding.x, frame.Max.y - padding.y);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(frame.Min, frame.Max, GetColorU32(ImWidgetsCol_HistogramBg), ImGui::GetStyle().FrameRounding);
+    if (bins.BinsCount == 0) {
+        ImGui::PopID();
+        return;
+    }
+
+    // Until a binning job finishes, the bins drawn are those of the previous inputs
+    bins_count = bins.BinsCount;
+
+    // Bins narrower than a pixel share a column drawn at the tallest of them
+    const int columns_count = ImClamp((int)inner.GetWidth(), 1, bins_count);
+    st.Columns.assign(columns_count, 0.0f);
+    for (int b = 0; b < bins_count; b++) {
+        float& column = st.Columns[(ImS64)b * columns_count / bins_count];
+        column = ImMax(column, (float)bins.Counts[b + 1]);
+    }
+
+    int hovered_column = -1;
+    if (ImGui::IsItemHovered() && inner.Contains(ImGui::GetIO().MousePos))
+        hovered_column = ImClamp((int)((ImGui::GetIO().MousePos.x - inner.Min.x) * columns_count / inner.GetWidth()), 0, columns_count - 1);
+
+    // All bars in one reservation: a quad per column
+    const float column_width = inner.GetWidth() / columns_count;
+    const float y_scale = bins.MaxCount > 0 ? inner.GetHeight() / bins.MaxCount : 0.0f;
+    const ImU32 col_bar = GetColorU32(ImWidgetsCol_HistogramBar);
+    const ImU32 col_hovered = GetColorU32(ImWidgetsCol_HistogramBarHovered);
+    draw_list->PrimReserve(columns_count * 6, columns_count * 4);
+    for (int c = 0; c < columns_count; c++) {
+        float x0 = inner.Min.x + c * column_width;
+        float x1 = ImMax(x0 + 1.0f, inner.Min.x + (c + 1) * column_width - (column_width >= 4.0f ? 1.0f : 0.0f));
+        draw_list->PrimRect(ImVec2(x0, inner.Max.y - st.Columns[c] * y_scale), ImVec2(x1, inner.Max.y), c == hovered_column ? col_hovered : col_bar);
+    }
+
+    if (!(flags & ImHistogramFlags_NoLabels)) {
+        char buf[32];
+        const ImU32 col_text = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+        snprintf(buf, sizeof(buf), "%d", bins.MaxCount);
+        draw_list->AddText(inner.Min, col_text, buf);
+        snprintf(buf, sizeof(buf), "%g", bins.RangeMin);
+        draw_list->AddText(ImVec2(inner.Min.x, inner.Max.y - ImGui::GetTextLineHeight()), col_text, buf);
+        snprintf(buf, sizeof(buf), "%g", bins.RangeMax);
+        draw_list->AddText(ImVec2(inner.Max.x - ImGui::CalcTextSize(buf).x, inner.Max.y - ImGui::GetTextLineHeight()), col_text, buf);
+    }
+
+    if (hovered_column >= 0 && !(flags & ImHistogramFlags_NoTooltip)) {
+        const int first_bin = (int)(((ImS64)hovered_column * bins_count + columns_count - 1) / columns_count);
+        const int last_bin = (int)(((ImS64)(hovered_column + 1) * bins_count + columns_count - 1) / columns_count);
+        const float bin_width = (bins.RangeMax - bins.RangeMin) / bins_count;
+        int count = 0;
+        for (int b = first_bin; b < last_bin; b++)
+            count += bins.Counts[b + 1];
+        ImGui::SetTooltip("[%g, %g): %d", bins.RangeMin + first_bin * bin_width, bins.RangeMin + last_bin * bin_width, count);
+    }
+    ImGui::PopID();
+}
+
+/*
+    HEATMAP
+*/
+
+// Writes lut[clamp((v - scale_min) * scale, 0, 255)] for each of v[0, n), NaNs map to lut[0]
+static void ColormapValues(const float* v, int n, float scale_min, float scale, const ImU32* lut, ImU32* out) {
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256 min8 = _mm256_set1_ps(scale_min), scale8 = _mm256_set1_ps(scale);
+    const __m256 zero8 = _mm256_setzero_ps(), last8 = _mm256_set1_ps(255.0f);
+    for (; i + 8 <= n; i += 8) {
+        __m256 t = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(v + i), min8), scale8);
+        t = _mm256_min_ps(_mm256_max_ps(t, zero8), last8);
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_i32gather_epi32((const int*)lut, _mm256_cvttps_epi32(t), 4));
+    }
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 min4 = _mm_set1_ps(scale_min), scale4 = _mm_set1_ps(scale);
+    const __m128 zero4 = _mm_setzero_ps(), last4 = _mm_set1_ps(255.0f);
+    alignas(16) int index[4];
+    for (; i + 4 <= n; i += 4) {
+        __m128 t = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(v + i), min4), scale4);
+        t = _mm_min_ps(_mm_max_ps(t, zero4), last4);
+        _mm_store_si128((__m128i*)index, _mm_cvttps_epi32(t));
+        out[i + 0] = lut[index[0]];
+        out[i + 1] = lut[index[1]];
+        out[i + 2] = lut[index[2]];
+        out[i + 3] = lut[index[3]];
+    }
+#endif
+    for (; i < n; i++) {
+        float t = (v[i] - scale_min) * scale;
+        out[i] = lut[t >= 0.0f ? (int)ImMin(t, 255.0f) : 0];
+    }
+}
+
+// RGBA texture written by a widget and uploaded by the renderer backend (ImGuiBackendFlags_RendererHasTextures),
+// with the same Updates bookkeeping the font atlas does for its own textures
+struct ImDynamicTexture {
+    ImTextureData*  Texture = nullptr;
+    ImVector<ImTextureData*> RetiredTextures;   // Waiting for the backend to destroy them
+
+    ImDynamicTexture() = default;
+    ImDynamicTexture(const ImDynamicTexture&) = delete;
+    ImDynamicTexture& operator=(const ImDynamicTexture&) = delete;
+    ~ImDynamicTexture() {
+        IM_DELETE(Texture);
+        for (ImTextureData* tex : RetiredTextures)
+            IM_DELETE(tex);
+    }
+
+    // Once per frame before writing pixels: returns true when the texture was (re)created and every pixel must be written
+    bool Begin(int width, int height) {
+        IM_ASSERT((ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasTextures) && "Needs a renderer backend supporting ImTextureData");
+        CollectRetired();
+        ImTextureData* tex = Texture;
+        if (tex && tex->Status == ImTextureStatus_OK) {
+            // Backend uploads of the previous frame are done
+            tex->Updates.resize(0);
+            tex->UpdateRect.x = tex->UpdateRect.y = (unsigned short)~0;
+            tex->UpdateRect.w = tex->UpdateRect.h = 0;
+        }
+        if (tex && tex->Width == width && tex->Height == height)
+            return false;
+        Retire();
+        tex = Texture = IM_NEW(ImTextureData)();
+        tex->Create(ImTextureFormat_RGBA32, width, height);
+        tex->UseColors = true;
+        tex->UsedRect = { 0, 0, (unsigned short)width, (unsigned short)height };
+        ImGui::RegisterUserTexture(tex);
+        return true;
+    }
+
+    ImU32* GetPixelsAt(int x, int y) { return (ImU32*)Texture->GetPixelsAt(x, y); }
+
+    void QueueUpload(int x, int y, int w, int h) {
+        ImTextureData* tex = Texture;
+        if (tex->Status == ImTextureStatus_WantCreate)
+            return;
+        ImTextureRect req = { (unsigned short)x, (unsigned short)y, (unsigned short)w, (unsigned short)h };
+        int x1 = ImMax(tex->UpdateRect.w == 0 ? 0 : tex->UpdateRect.x + tex->UpdateRect.w, x + w);
+        int y1 = ImMax(tex->UpdateRect.h == 0 ? 0 : tex->UpdateRect.y + tex->UpdateRect.h, y + h);
+        tex->UpdateRect.x = ImMin(tex->UpdateRect.x, req.x);
+        tex->UpdateRect.y = ImMin(tex->UpdateRect.y, req.y);
+        tex->UpdateRect.w = (unsigned short)(x1 - tex->UpdateRect.x);
+        tex->UpdateRect.h = (unsigned short)(y1 - tex->UpdateRect.y);
+        tex->SetStatus(ImTextureStatus_WantUpdates);
+        tex->Updates.push_back(req);
+    }
+
+    // Backends only destroy a texture with UnusedFrames > 0 (imgui.h: "Always >0 when Status==WantDestroy"), which
+    // ImGui only counts for atlas textures: it is counted here. The pixels are no longer needed by then.
+    void Retire() {
+        if (!Texture)
+            return;
+        Texture->SetStatus(Texture->Status == ImTextureStatus_WantCreate ? ImTextureStatus_Destroyed : ImTextureStatus_WantDestroy);
+        Texture->UnusedFrames = 1;
+        Texture->Updates.clear();
+        Texture->DestroyPixels();
+        RetiredTextures.push_back(Texture);
+        Texture = nullptr;
+    }
+
+    void CollectRetired() {
+        for (int i = 0; i < RetiredTextures.Size; ) {
+            ImTextureData* tex = RetiredTextures[i];
+            if (tex->Status != ImTextureStatus_Destroyed) {
+                tex->UnusedFrames++;
+                i++;
+                continue;
+            }
+            ImGui::UnregisterUserTexture(tex);
+            IM_DELETE(tex);
+            RetiredTextures.erase(RetiredTextures.Data + i);
+        }
+    }
+};
+
+// 256 entry colormap through three colors
+static void BuildColormapLut(const ImVec4 colors[3], ImU32* lut) {
+    for (int i = 0; i < 256; i++) {
+        float t = i / 255.0f * 2.0f;
+        ImVec4 c = t < 1.0f ? ImLerp(colors[0], colors[1], t) : ImLerp(colors[1], colors[2], t - 1.0f);
+        lut[i] = ImGui::ColorConvertFloat4ToU32(c);
+    }
+}
+
+struct ImHeatmapState {
+    ImDynamicTexture Texture;
+    ImVector<ImTextureRect> DirtyRects;
+    ImU32           Lut[256];
+    ImVec4          LutColors[3] = { ImVec4(-1.0f, 0.0f, 0.0f, 0.0f) };     // Never a style color, so the first frame builds the table
+    int             Version = 0;
+    float           ScaleMin = 0.0f;
+    float           ScaleMax = 0.0f;
+
+    void Recolor(const float* values, int columns, int x, int y, int w, int h, float scale) {
+        for (int row = y; row < y + h; row++)
+            ColormapValues(values + (size_t)row * columns + x, w, ScaleMin, scale, Lut, Texture.GetPixelsAt(x, row));
+        Texture.QueueUpload(x, y, w, h);
+    }
+};
+
+static ImHeatmapState& GetHeatmapState(ImGuiID id) {
+    return GetStatePool<ImHeatmapState>(ImWidgetsContextSlot_Heatmap)[id];
+}
+
+void ImWidgets::HeatmapInvalidate(const char* label, int x, int y, int w, int h) {
+    ImHeatmapState& st = GetHeatmapState(ImGui::GetID(label));
+    if (w > 0 && h > 0)
+        st.DirtyRects.push_back({ (unsigned short)x, (unsigned short)y, (unsigned short)w, (unsigned short)h });
+}
+
+void ImWidgets::Heatmap(const char* label, const float* values, int columns, int rows, float scale_min, float scale_max, int values_version, ImHeatmapFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    IM_ASSERT(columns > 0 && rows > 0 && columns <= 0xFFFF && rows <= 0xFFFF);
+    ImHeatmapState& st = GetHeatmapState(ImGui::GetID(label));
+
+    bool full = st.Texture.Begin(columns, rows);
+    const ImVec4 colors[3] = { style.ImHeatmapLowColor, style.ImHeatmapMidColor, style.ImHeatmapHighColor };
+    if (memcmp(colors, st.LutColors, sizeof(colors)) != 0) {
+        BuildColormapLut(colors, st.Lut);
+        memcpy(st.LutColors, colors, sizeof(colors));
+        full = true;
+    }
+    if (values_version != st.Version || scale_min != st.ScaleMin || scale_max != st.ScaleMax) {
+        st.Version = values_version;
+        st.ScaleMin = scale_min;
+        st.ScaleMax = scale_max;
+        full = true;
+    }
+
+    // Only changed cells are colormapped and uploaded
+    const float scale = scale_max != scale_min ? 255.999f / (scale_max - scale_min) : 0.0f;
+    if (full) {
+        st.Recolor(values, columns, 0, 0, columns, rows, scale);
+    }
+    else {
+        for (const ImTextureRect& r : st.DirtyRects) {
+            int x = ImMin((int)r.x, columns), y = ImMin((int)r.y, rows);
+            int w = ImMin((int)r.w, columns - x), h = ImMin((int)r.h, rows - y);
+            if (w > 0 && h > 0)
+                st.Recolor(values, columns, x, y, w, h, scale);
+        }
+    }
+    st.DirtyRects.resize(0);
+
+    ImGui::PushID(label);
+    ImVec2 size = ImGui::CalcItemSize(style.ImHeatmapSize, ImGui::CalcItemWidth(), ImGui::CalcItemWidth() * rows / columns);
+    ImGui::InvisibleButton("##heatmap", size);
+    const ImVec2 p_min = ImGui::GetItemRectMin(), p_max = ImGui::GetItemRectMax();
+    ImGui::GetWindowDrawList()->AddImage(st.Texture.Texture->GetTexRef(), p_min, p_max);
+
+    if (ImGui::IsItemHovered() && !(flags & ImHeatmapFlags_NoTooltip)) {
+        ImVec2 mouse = ImGui::GetIO().MousePos;
+        int x = ImClamp((int)((mouse.x - p_min.x) / size.x * columns), 0, columns - 1);
+        int y = ImClamp((int)((mouse.y - p_min.y) / size.y * rows), 0, rows - 1);
+        ImGui::SetTooltip("[%d, %d] %g", x, y, values[(size_t)y * columns + x]);
+    }
+    ImGui::PopID();
+}
+
+/*
+    SPARKLINE
+*/
+
+struct ImSparklineState {
+    // Decimated geometry for (Version, Count, Width, Height): a top and bottom y per pixel column
+    std::vector<ImVec2> Columns;
+    int     Version = -1;
+    int     Count = -1;
+    int     Width = 0;
+    float   Height = 0.0f;
+    float   Min = 0.0f;
+    float   Max = 0.0f;
+
+    void Update(const float* values, int values_count, int values_version, int width, float height) {
+        if (values_version == Version && values_count == Count && width == Width && height == Height)
+            return;
+        Version = values_version;
+        Count = values_count;
+        Width = width;
+        Height = height;
+        Columns.resize(values_count > 0 ? width : 0);
+        if (values_count <= 0)
+            return;
+
+        // Per column min/max, linearly interpolated when there are fewer samples than columns
+        for (int x = 0; x < width; x++) {
+            ImLinePlotBucket b;
+            if (values_count >= width) {
+                int begin = (int)((ImS64)values_count * x / width), end = (int)((ImS64)values_count * (x + 1) / width);
+                b = ComputeBucket(values + begin, end - begin);
+            }
+            else {
+                float t = width > 1 ? (float)x * (values_count - 1) / (width - 1) : 0.0f;
+                int i = ImMin((int)t, values_count - 1);
+                float v = i + 1 < values_count ? ImLerp(values[i], values[i + 1], t - i) : values[i];
+                b = { v, v, v };
+            }
+            Columns[x] = ImVec2(b.Min, b.Max);
+        }
+        Min = FLT_MAX;
+        Max = -FLT_MAX;
+        for (const ImVec2& c : Columns) {
+            Min = ImMin(Min, c.x);
+            Max = ImMax(Max, c.y);
+        }
+
+        // To pixels, each column stretched to touch its neighbour so the line stays connected
+        const float scale = Max > Min ? (height - 1.0f) / (Max - Min) : 0.0f;
+        float prev_top = 0.0f, prev_bottom = 0.0f;
+        for (int x = 0; x < width; x++) {
+            float top = height - 1.0f - (Columns[x].y - Min) * scale;
+            float bottom = height - (Columns[x].x - Min) * scale;
+            Columns[x] = ImVec2(x > 0 ? ImMin(top, prev_bottom - 1.0f) : top, x > 0 ? ImMax(bottom, prev_top + 1.0f) : bottom);
+            prev_top = top;
+            prev_bottom = bottom;
+        }
+    }
+};
+
+struct ImSparklineBatchItem {
+    ImDrawList*             DrawList;
+    ImVec4                  ClipRect;       // Clip rectangle in effect when the sparkline was submitted (tables, child regions...)
+    ImVec2                  Pos;
+    ImU32                   Color;
+    const ImSparklineState* State;
+};
+
+// Sparklines submitted between BeginSparklines() and EndSparklines()
+struct ImSparklineBatch : ImWidgetsContextData {
+    bool    Batching = false;
+    std::vector<ImSparklineBatchItem> Items;
+};
+
+// Writes the quads of items [begin, end), all from the same window, with as few reservations as the index type allows.
+// Items may have been submitted under different clip rectangles: the draw command clips to their union and each
+// column is clipped to its own item's rectangle on the CPU, which is exact since columns are axis aligned and untextured.
+static void DrawSparklineItems(const ImSparklineBatchItem* begin, const ImSparklineBatchItem* end) {
+    ImDrawList* draw_list = begin->DrawList;
+    const int max_quads = sizeof(ImDrawIdx) == 2 ? 0xFFFF / 4 : INT_MAX / 6;
+    int total = 0;
+    ImRect clip_union(begin->ClipRect);
+    for (const ImSparklineBatchItem* it = begin; it < end; it++) {
+        total += (int)it->State->Columns.size();
+        clip_union.Add(ImRect(it->ClipRect));
+    }
+
+    draw_list->PushClipRect(clip_union.Min, clip_union.Max);
+    const ImSparklineBatchItem* item = begin;
+    int column = 0;
+    while (total > 0) {
+        int quads = ImMin(total, max_quads);
+        total -= quads;
+        draw_list->PrimReserve(quads * 6, quads * 4);
+        int unused = 0;
+        while (quads > 0) {
+            const std::vector<ImVec2>& columns = item->State->Columns;
+            const ImVec4& clip = item->ClipRect;
+            const int count = ImMin(quads, (int)columns.size() - column);
+            for (int i = column; i < column + count; i++) {
+                const float x = item->Pos.x + i;
+                const ImVec2 a(ImMax(x, clip.x), ImMax(item->Pos.y + columns[i].x, clip.y));
+                const ImVec2 b(ImMin(x + 1.0f, clip.z), ImMin(item->Pos.y + columns[i].y, clip.w));
+                if (a.x < b.x && a.y < b.y)
+                    draw_list->PrimRect(a, b, item->Color);
+                else
+                    unused++;
+            }
+            quads -= count;
+            column += count;
+            if (column == (int)columns.size()) {
+                item++;
+                column = 0;
+            }
+        }
+        draw_list->PrimUnreserve(unused * 6, unused * 4);
+    }
+    draw_list->PopClipRect();
+}
+
+void ImWidgets::BeginSparklines() {
+    ImSparklineBatch& batch = GetContextData<ImSparklineBatch>(ImWidgetsContextSlot_SparklineBatch);
+    IM_ASSERT(!batch.Batching && "Calling BeginSparklines() twice without EndSparklines()");
+    batch.Batching = true;
+    batch.Items.clear();
+}
+
+void ImWidgets::EndSparklines() {
+    ImSparklineBatch& batch = GetContextData<ImSparklineBatch>(ImWidgetsContextSlot_SparklineBatch);
+    std::vector<ImSparklineBatchItem>& items = batch.Items;
+    IM_ASSERT(batch.Batching && "Calling EndSparklines() without BeginSparklines()");
+    batch.Batching = false;
+    // Stable so each draw list's items, typically one per window, end up contiguous and in submission order
+    std::stable_sort(items.begin(), items.end(), [](const ImSparklineBatchItem& a, const ImSparklineBatchItem& b) {
+        return a.DrawList < b.DrawList;
+    });
+    for (size_t begin = 0, end; begin < items.size(); begin = end) {
+        for (end = begin + 1; end < items.size() && items[end].DrawList == items[begin].DrawList; end++) {}
+        DrawSparklineItems(items.data() + begin, items.data() + end);
+    }
+    items.clear();
+}
+
+void ImWidgets::Sparkline(const char* label, const float* values, int values_count, int values_version, ImSparklineFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImGuiID id = ImGui::GetID(label);
+
+    ImVec2 size = ImGui::CalcItemSize(style.ImSparklineSize, ImGui::CalcItemWidth(), ImGui::GetFrameHeight());
+    ImGui::Dummy(size);
+    if (!ImGui::IsItemVisible())
+        return;
+
+    std::unordered_map<ImGuiID, ImSparklineState>& sparklineStates = GetStatePool<ImSparklineState>(ImWidgetsContextSlot_Sparkline);
+    ImSparklineState& st = sparklineStates[id];
+    const ImVec2 pos = ImGui::GetItemRectMin();
+    st.Update(values, values_count, values_version, (int)size.x, IM_TRUNC(size.y));
+    if (st.Columns.empty())
+        return;
+
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    ImSparklineBatchItem item = { window->DrawList, window->DrawList->_CmdHeader.ClipRect, ImVec2(IM_TRUNC(pos.x), IM_TRUNC(pos.y)), GetColorU32(ImWidgetsCol_Sparkline), &st };
+    ImSparklineBatch& batch = GetContextData<ImSparklineBatch>(ImWidgetsContextSlot_SparklineBatch);
+    if (batch.Batching)
+        batch.Items.push_back(item);
+    else
+        DrawSparklineItems(&item, &item + 1);
+
+    if (!(flags & ImSparklineFlags_NoTooltip) && ImGui::IsItemHovered() && values_count > 0)
+        ImGui::SetTooltip("min %g, max %g, last %g", st.Min, st.Max, values[values_count - 1]);
+}
+
+/*
+    SCATTER PLOT
+*/
+
+struct ImScatterView {
+    double MinX, MinY, MaxX, MaxY;
+
+    bool operator==(const ImScatterView& o) const { return MinX == o.MinX && MinY == o.MinY && MaxX == o.MaxX && MaxY == o.MaxY; }
+    bool operator!=(const ImScatterView& o) const { return !(*this == o); }
+};
+
+// Uniform grid over the data bounds with the points sorted by cell: hover looks only at the cells around the cursor
+struct ImScatterIndex {
+    ImScatterView       Bounds;
+    int                 Grid = 0;           // Cells per axis
+    double              CellScaleX = 0.0;   // Cells per data unit
+    double              CellScaleY = 0.0;
+    std::vector<int>    CellStart;          // Grid * Grid + 1 offsets into Order
+    std::vector<int>    Order;
+
+    int CellX(double x) const { return ImClamp((int)((x - Bounds.MinX) * CellScaleX), 0, Grid - 1); }
+    int CellY(double y) const { return ImClamp((int)((y - Bounds.MinY) * CellScaleY), 0, Grid - 1); }
+
+    void Build(const float* xs, const float* ys, int n, const std::atomic<bool>& cancel) {
+        // Extent of the finite points
+        Bounds = { DBL_MAX, DBL_MAX, -DBL_MAX, -DBL_MAX };
+        for (int i = 0; i < n && !cancel; i++) {
+            if (xs[i] != xs[i] || ys[i] != ys[i])
+                continue;
+            Bounds.MinX = ImMin(Bounds.MinX, (double)xs[i]);
+            Bounds.MaxX = ImMax(Bounds.MaxX, (double)xs[i]);
+            Bounds.MinY = ImMin(Bounds.MinY, (double)ys[i]);
+            Bounds.MaxY = ImMax(Bounds.MaxY, (double)ys[i]);
+        }
+        if (Bounds.MinX > Bounds.MaxX)
+            Bounds = { 0.0, 0.0, 1.0, 1.0 };
+
+        // About 8 points per cell, sorted by cell with a counting sort
+        Grid = ImClamp((int)sqrt(n / 8.0), 1, 2048);
+        CellScaleX = Grid / ImMax(Bounds.MaxX - Bounds.MinX, 1e-30) * 0.999999;
+        CellScaleY = Grid / ImMax(Bounds.MaxY - Bounds.MinY, 1e-30) * 0.999999;
+        std::vector<int> cells(n);
+        CellStart.assign((size_t)Grid * Grid + 1, 0);
+        for (int i = 0; i < n && !cancel; i++) {
+            cells[i] = (xs[i] != xs[i] || ys[i] != ys[i]) ? -1 : CellY(ys[i]) * Grid + CellX(xs[i]);
+            if (cells[i] >= 0)
+                CellStart[cells[i] + 1]++;
+        }
+        for (size_t c = 1; c < CellStart.size(); c++)
+            CellStart[c] += CellStart[c - 1];
+        Order.resize(CellStart.back());
+        std::vector<int> fill(CellStart.begin(), CellStart.end() - 1);
+        for (int i = 0; i < n && !cancel; i++)
+            if (cells[i] >= 0)
+                Order[fill[cells[i]]++] = i;
+    }
+
+    // Closest point within an ellipse of radii (rx, ry) around (x, y), i.e. a circle in screen space, or -1
+    int Nearest(const float* xs, const float* ys, double x, double y, double rx, double ry) const {
+        const int max_scanned = 1 << 16;
+        const int cx0 = CellX(x - rx), cx1 = CellX(x + rx);
+        const int cy0 = CellY(y - ry), cy1 = CellY(y + ry);
+        int best = -1, scanned = 0;
+        double best_d2 = 1.0;
+        for (int cy = cy0; cy <= cy1 && scanned < max_scanned; cy++) {
+            for (int cx = cx0; cx <= cx1 && scanned < max_scanned; cx++) {
+                const int cell = cy * Grid + cx;
+                for (int k = CellStart[cell]; k < CellStart[cell + 1]; k++, scanned++) {
+                    const int i = Order[k];
+                    const double dx = (xs[i] - x) / rx, dy = (ys[i] - y) / ry;
+                    if (dx * dx + dy * dy <= best_d2) {
+                        best_d2 = dx * dx + dy * dy;
+                        best = i;
+                    }
+                }
+            }
+        }
+        return best;
+    }
+};
+
+struct ImScatterIndexJob : ImWidgetsJob {
+    ImScatterIndex      Index;
+};
+
+// Counts the points falling in each pixel of View, spread over the pool
+struct ImScatterBinJob : ImWidgetsJob {
+    ImScatterView       View;
+    int                 Width = 0;
+    int                 Height = 0;
+    int                 Generation = 0;
+    std::vector<int>    Counts;
+    int                 MaxCount = 0;
+
+    void Run(const float* xs, const float* ys, int n) {
+        const int min_part_size = 1 << 18;
+        const int parts = ImMin(TaskPoolThreads(), ImMax(n / min_part_size, 1));
+        const double sx = Width / (View.MaxX - View.MinX), sy = Height / (View.MaxY - View.MinY);
+        std::vector<std::vector<int>> part_counts(parts);
+        auto bin = [&](int p) {
+            std::vector<int>& counts = part_counts[p];
+            counts.assign((size_t)Width * Height, 0);
+            const int begin = (int)((ImS64)n * p / parts), end = (int)((ImS64)n * (p + 1) / parts);
+            for (int i = begin; i < end; i++) {
+                if ((i & 0xFFFF) == 0 && Cancel)
+                    return;
+                const double px = (xs[i] - View.MinX) * sx, py = (View.MaxY - ys[i]) * sy;
+                if (px >= 0.0 && px < Width && py >= 0.0 && py < Height)    // NaNs fail every comparison
+                    counts[(int)py * Width + (int)px]++;
+            }
+        };
+        ParallelFor(parts, bin);
+        Counts.swap(part_counts[0]);
+        for (int p = 1; p < parts && !Cancel; p++)
+            for (size_t c = 0; c < Counts.size(); c++)
+                Counts[c] += part_counts[p][c];
+        MaxCount = 0;
+        for (int c : Counts)
+            MaxCount = ImMax(MaxCount, c);
+    }
+};
+
+// Filled rectangles reserved in chunks small enough for 16-bit indices
+// Reserves capacity_hint quads up front (at least 64, at most one 16-bit indexed draw command worth), then twice the
+// previous reservation each time the hint turns out too small
+struct ImQuadWriter {
+    ImDrawList* DrawList;
+    int         Hint;
+    int         Reserved = 0;
+    int         Used = 0;
+
+    ImQuadWriter(ImDrawList* draw_list, int capacity_hint) : DrawList(draw_list), Hint(capacity_hint) {}
+    ~ImQuadWriter() { Flush(); }
+
+    void AddRect(const ImVec2& min, const ImVec2& max, ImU32 col) {
+        if (Used == Reserved) {
+            Flush();
+            Reserved = ImClamp(Hint, 64, sizeof(ImDrawIdx) == 2 ? 0xFFFF / 4 : 1 << 16);
+            Hint = Hint > Reserved ? Hint - Reserved : Reserved * 2;
+            DrawList->PrimReserve(Reserved * 6, Reserved * 4);
+        }
+        DrawList->PrimRect(min, max, col);
+        Used++;
+    }
+
+    void Flush() {
+        DrawList->PrimUnreserve((Reserved - Used) * 6, (Reserved - Used) * 4);
+        Reserved = Used = 0;
+    }
+};
+
+struct ImScatterPlotState {
+    bool                Fit = true;
+    ImScatterView       View = { 0.0, 0.0, 1.0, 1.0 };
+    int                 Version = -1;
+    int                 Count = -1;
+    int                 Generation = 0;         // Bumped on every Reset(), so bins of older points are redone
+
+    ImWidgetsJobPtr<ImScatterIndexJob> IndexJob;
+    ImScatterIndex      Index;
+    bool                IndexReady = false;
+
+    // Density of the last finished binning, for TextureView
+    ImWidgetsJobPtr<ImScatterBinJob> BinJob;
+    std::vector<int>    Counts;
+    std::vector<float>  Density;
+    int                 MaxCount = 0;
+    int                 BinsWidth = 0;
+    int                 BinsHeight = 0;
+    int                 BinsGeneration = -1;
+    ImScatterView       BinsView = { 0.0, 0.0, 0.0, 0.0 };
+    bool                TextureDirty = false;
+    ImDynamicTexture    Texture;
+    int                 MarkersCell = 0;    // Bin size MarkersDensity was reduced for, 0 when stale
+    std::vector<float>  MarkersDensity;
+    ImU32               Lut[256];
+    ImVec4              LutColor = ImVec4(-1.0f, 0.0f, 0.0f, 0.0f);
+
+    void Reset(ImGuiID owner, const float* xs, const float* ys, int n, int version) {
+        IndexJob.reset();
+        BinJob.reset();
+        Version = version;
+        Count = n;
+        Generation++;
+        IndexReady = false;
+        IndexJob.reset(new ImScatterIndexJob());
+        ImScatterIndexJob* job = IndexJob.get();
+        job->Start(owner, [job, xs, ys, n]() { job->Index.Build(xs, ys, n, job->Cancel); });
+    }
+
+    void StartBinning(ImGuiID owner, const float* xs, const float* ys, int n, const ImScatterView& view, int width, int height) {
+        BinJob.reset(new ImScatterBinJob());
+        ImScatterBinJob* job = BinJob.get();
+        job->View = view;
+        job->Width = width;
+        job->Height = height;
+        job->Generation = Generation;
+        job->Start(owner, [job, xs, ys, n]() { job->Run(xs, ys, n); });
+    }
+
+    void FinishBinning() {
+        ImScatterBinJob& job = *BinJob;
+        Counts.swap(job.Counts);
+        MaxCount = job.MaxCount;
+        BinsWidth = job.Width;
+        BinsHeight = job.Height;
+        BinsGeneration = job.Generation;
+        BinsView = job.View;
+        BinJob.reset();
+
+        // Log density mapped to [1, 255], empty pixels to 0
+        Density.resize(Counts.size());
+        const float scale = MaxCount > 1 ? 254.0f / logf((float)MaxCount) : 0.0f;
+        for (size_t c = 0; c < Counts.size(); c++)
+            Density[c] = Counts[c] > 0 ? 1.0f + logf((float)Counts[c]) * scale : 0.0f;
+        TextureDirty = true;
+        MarkersCell = 0;
+    }
+};
+
+void ImWidgets::ScatterPlot(const char* label, const float* xs, const float* ys, int points_count, int points_version, ImScatterPlotFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, ImScatterPlotState>& scatterPlotStates = GetStatePool<ImScatterPlotState>(ImWidgetsContextSlot_ScatterPlot);
+    ImScatterPlotState& st = scatterPlotStates[id];
+    points_count = ImMax(points_count, 0);
+    // Jobs cancelled while the plot was out of sight start over
+    if (JobOutdated(id, st.IndexJob.get(), points_version != st.Version || points_count != st.Count))
+        st.Reset(id, xs, ys, points_count, points_version);
+    if (st.IndexJob && st.IndexJob->Done) {
+        st.Index = std::move(st.IndexJob->Index);
+        st.IndexJob.reset();
+        st.IndexReady = true;
+    }
+
+    ImGui::PushID(label);
+    ImVec2 size = ImGui::CalcItemSize(style.ImScatterPlotSize, ImGui::CalcItemWidth(), ImGui::CalcItemWidth() * 0.6f);
+    ImGui::InvisibleButton("##scatter", size);
+    const ImRect frame(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    const bool hovered = ImGui::IsItemHovered();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(frame.Min, frame.Max, GetColorU32(ImWidgetsCol_ScatterPlotBg), ImGui::GetStyle().FrameRounding);
+    if (!st.IndexReady) {
+        draw_list->AddText(ImVec2(frame.Min.x + ImGui::GetStyle().FramePadding.x, frame.Min.y + ImGui::GetStyle().FramePadding.y), ImGui::GetColorU32(ImGuiCol_TextDisabled), "Indexing...");
+        ImGui::PopID();
+        return;
+    }
+
+    // Wheel zooms around the mouse, dragging pans, double-click fits every point again
+    ImScatterView& view = st.View;
+    const double units_per_pixel_x = (view.MaxX - view.MinX) / size.x;
+    const double units_per_pixel_y = (view.MaxY - view.MinY) / size.y;
+    if (!(flags & ImScatterPlotFlags_NoInteraction)) {
+        ImGuiIO& io = ImGui::GetIO();
+        if (hovered) {
+            ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
+            if (io.MouseWheel != 0.0f) {
+                double anchor_x = view.MinX + (io.MousePos.x - frame.Min.x) * units_per_pixel_x;
+                double anchor_y = view.MaxY - (io.MousePos.y - frame.Min.y) * units_per_pixel_y;
+                double scale = io.MouseWheel > 0.0f ? 0.8 : 1.25;
+                view = { anchor_x - (anchor_x - view.MinX) * scale, anchor_y - (anchor_y - view.MinY) * scale,
+                         anchor_x + (view.MaxX - anchor_x) * scale, anchor_y + (view.MaxY - anchor_y) * scale };
+                st.Fit = false;
+            }
+            if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+                st.Fit = true;
+        }
+        if (ImGui::IsItemActive() && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)) {
+            view.MinX -= io.MouseDelta.x * units_per_pixel_x;
+            view.MaxX -= io.MouseDelta.x * units_per_pixel_x;
+            view.MinY += io.MouseDelta.y * units_per_pixel_y;
+            view.MaxY += io.MouseDelta.y * units_per_pixel_y;
+            st.Fit = false;
+        }
+    }
+    if (st.Fit) {
+        const ImScatterView& b = st.Index.Bounds;
+        const double margin_x = ImMax(b.MaxX - b.MinX, 1e-6) * 0.02, margin_y = ImMax(b.MaxY - b.MinY, 1e-6) * 0.02;
+        view = { b.MinX - margin_x, b.MinY - margin_y, b.MaxX + margin_x, b.MaxY + margin_y };
+    }
+
+    const double sx = size.x / (view.MaxX - view.MinX), sy = size.y / (view.MaxY - view.MinY);
+    auto to_screen = [&](double x, double y) { return ImVec2((float)(frame.Min.x + (x - view.MinX) * sx), (float)(frame.Min.y + (view.MaxY - y) * sy)); };
+    const float marker = style.ImScatterPlotMarkerSize;
+    const ImU32 col_marker = GetColorU32(ImWidgetsCol_ScatterPlot);
+    draw_list->PushClipRect(frame.Min, frame.Max, true);
+
+    if (points_count <= style.ImScatterPlotMaxMarkers) {
+        // Few enough points to draw each of them
+        ImQuadWriter writer(draw_list, points_count);
+        for (int i = 0; i < points_count; i++) {
+            ImVec2 p = to_screen(xs[i], ys[i]);
+            if (p.x >= frame.Min.x - marker && p.x <= frame.Max.x + marker && p.y >= frame.Min.y - marker && p.y <= frame.Max.y + marker)
+                writer.AddRect(ImVec2(p.x - marker * 0.5f, p.y - marker * 0.5f), ImVec2(p.x + marker * 0.5f, p.y + marker * 0.5f), col_marker);
+        }
+    }
+    else {
+        // Binning happens on the task pool when the view settles, meanwhile the last bins are drawn where they belong
+        const int width = ImMax((int)size.x, 1), height = ImMax((int)size.y, 1);
+        if (st.BinJob && st.BinJob->Done)
+            st.FinishBinning();
+        else if (st.BinJob && st.BinJob->Abandoned())
+            st.BinJob.reset();
+        if (!st.BinJob && (st.BinsGeneration != st.Generation || st.BinsView != view || st.BinsWidth != width || st.BinsHeight != height))
+            st.StartBinning(id, xs, ys, points_count, view, width, height);
+
+        if (st.MaxCount > 0) {
+            const ImVec2 bins_min = to_screen(st.BinsView.MinX, st.BinsView.MaxY);
+            const ImVec2 bins_max = to_screen(st.BinsView.MaxX, st.BinsView.MinY);
+            if (flags & ImScatterPlotFlags_BinnedMarkers) {
+                // One marker per cell of marker size, faded by density, at most ImScatterPlotMaxMarkers of them
+                const int cell = ImMax((int)ceilf(marker), (int)ceilf(sqrtf((float)st.BinsWidth * st.BinsHeight / ImMax(style.ImScatterPlotMaxMarkers, 1))));
+                const int cells_x = (st.BinsWidth + cell - 1) / cell, cells_y = (st.BinsHeight + cell - 1) / cell;
+                const float cell_scale_x = (bins_max.x - bins_min.x) / st.BinsWidth * cell, cell_scale_y = (bins_max.y - bins_min.y) / st.BinsHeight * cell;
+                const ImVec4 color = style.ImScatterPlotColor;
+                if (st.MarkersCell != cell) {
+                    st.MarkersDensity.assign((size_t)cells_x * cells_y, 0.0f);
+                    for (int y = 0; y < st.BinsHeight; y++)
+                        for (int x = 0; x < st.BinsWidth; x++) {
+                            float& density = st.MarkersDensity[(y / cell) * cells_x + x / cell];
+                            density = ImMax(density, st.Density[y * st.BinsWidth + x]);
+                        }
+                    st.MarkersCell = cell;
+                }
+                ImQuadWriter writer(draw_list, cells_x * cells_y);
+                for (int cy = 0; cy < cells_y; cy++) {
+                    for (int cx = 0; cx < cells_x; cx++) {
+                        const float density = st.MarkersDensity[cy * cells_x + cx];
+                        if (density <= 0.0f)
+                            continue;
+                        ImVec2 c(bins_min.x + (cx + 0.5f) * cell_scale_x, bins_min.y + (cy + 0.5f) * cell_scale_y);
+                        ImU32 col = ImGui::GetColorU32(ImVec4(color.x, color.y, color.z, color.w * (0.25f + 0.75f * density / 255.0f)));
+                        writer.AddRect(ImVec2(c.x - marker * 0.5f, c.y - marker * 0.5f), ImVec2(c.x + marker * 0.5f, c.y + marker * 0.5f), col);
+                    }
+                }
+            }
+            else {
+                // Density texture: transparent where empty, fading in to ImScatterPlotColor with the log of the count
+                if (st.Texture.Begin(st.BinsWidth, st.BinsHeight))
+                    st.TextureDirty = true;
+                if (memcmp(&style.ImScatterPlotColor, &st.LutColor, sizeof(ImVec4)) != 0) {
+                    const ImVec4 c = style.ImScatterPlotColor;
+                    const ImVec4 colors[3] = { ImVec4(c.x, c.y, c.z, c.w * 0.25f), ImVec4(c.x, c.y, c.z, c.w * 0.625f), c };
+                    BuildColormapLut(colors, st.Lut);
+                    st.Lut[0] = IM_COL32_BLACK_TRANS;
+                    st.LutColor = c;
+                    st.TextureDirty = true;
+                }
+                if (st.TextureDirty) {
+                    ColormapValues(st.Density.data(), (int)st.Density.size(), 0.0f, 1.0f, st.Lut, st.Texture.GetPixelsAt(0, 0));
+                    st.Texture.QueueUpload(0, 0, st.BinsWidth, st.BinsHeight);
+                    st.TextureDirty = false;
+                }
+                draw_list->AddImage(st.Texture.Texture->GetTexRef(), bins_min, bins_max);
+            }
+        }
+    }
+
+    // Hovered point, from the grid index
+    int hovered_point = -1;
+    if (hovered && !(flags & ImScatterPlotFlags_NoTooltip)) {
+        const ImVec2 mouse = ImGui::GetIO().MousePos;
+        const double radius = ImMax(marker, 4.0f);
+        hovered_point = st.Index.Nearest(xs, ys, view.MinX + (mouse.x - frame.Min.x) / sx, view.MaxY - (mouse.y - frame.Min.y) / sy, radius / sx, radius / sy);
+        if (hovered_point >= 0) {
+            ImVec2 p = to_screen(xs[hovered_point], ys[hovered_point]);
+            draw_list->AddCircle(p, marker + 2.0f, ImGui::GetColorU32(ImGuiCol_Text));
+            ImGui::SetTooltip("[%d] (%g, %g)", hovered_point, xs[hovered_point], ys[hovered_point]);
+        }
+    }
+    draw_list->PopClipRect();
+    ImGui::PopID();
+}
+
+/*
+    FLAME GRAPH
+*/
+
+int ImFlameGraphNames::Intern(const char* name, const char* name_end) {
+    if (!name_end)
+        name_end = name + strlen(name);
+    const int len = (int)(name_end - name);
+    for (ImGuiID hash = ImHashStr(name, len);; hash++) {
+        const int id = Lookup.GetInt(hash) - 1;
+        if (id < 0) {
+            Lookup.SetInt(hash, Offsets.Size + 1);
+            Offsets.push_back(Buffer.Size);
+            Buffer.resize(Buffer.Size + len + 1);
+            memcpy(Buffer.Data + Offsets.back(), name, len);
+            Buffer.back() = 0;
+            return Offsets.Size - 1;
+        }
+        if (GetEnd(id) - Get(id) == len && memcmp(Get(id), name, len) == 0)
+            return id;
+    }
+}
+
+// Children lists and horizontal offsets of every node, built once per nodes_version
+struct ImFlameGraphLayout {
+    std::vector<double> Start;          // Offset of each node in cost units, children start where their parent does
+    std::vector<int>    ChildStart;     // nodes_count + 2 offsets into Children, the last list holds the roots
+    std::vector<int>    Children;
+    int                 MaxDepth = 0;
+    double              Total = 0.0;
+
+    void Build(const ImFlameGraphNode* nodes, int n, const std::atomic<bool>& cancel) {
+        // List of each node's parent, n for the roots. A parent that does not come before its child would index out of
+        // range or read a depth not computed yet: the node is made a root instead
+        auto list_of = [nodes, n](int i) {
+            const int parent = nodes[i].Parent;
+            IM_ASSERT(parent < i && "ImFlameGraphNode::Parent must come before the node");
+            return parent >= 0 && parent < i ? parent : n;
+        };
+
+        // Counting sort by parent keeps siblings in array order, the roots go to the list at index n
+        ChildStart.assign((size_t)n + 2, 0);
+        for (int i = 0; i < n; i++)
+            ChildStart[list_of(i) + 1]++;
+        for (size_t p = 1; p < ChildStart.size(); p++)
+            ChildStart[p] += ChildStart[p - 1];
+        Children.resize(n);
+        std::vector<int> fill(ChildStart.begin(), ChildStart.end() - 1);
+        for (int i = 0; i < n && !cancel; i++)
+            Children[fill[list_of(i)]++] = i;
+
+        // Parents come first, so one pass places every node after its previous siblings
+        std::vector<double> next(n + 1, 0.0);
+        std::vector<int> depth(n);
+        Start.resize(n);
+        MaxDepth = 0;
+        for (int i = 0; i < n && !cancel; i++) {
+            const int list = list_of(i);
+            Start[i] = next[list];
+            next[list] += ImMax(nodes[i].Total, 0.0f);
+            next[i] = Start[i];
+            depth[i] = list < n ? depth[list] + 1 : 0;
+            MaxDepth = ImMax(MaxDepth, depth[i]);
+        }
+        Total = next[n];
+    }
+};
+
+struct ImFlameGraphLayoutJob : ImWidgetsJob {
+    ImFlameGraphLayout  Layout;
+};
+
+struct ImFlameGraphState {
+    double              ViewMin = 0.0;
+    double              ViewMax = 0.0;
+    bool                Fit = true;
+    float               ScrollY = 0.0f;     // Pixels scrolled away from the roots
+    int                 Version = -1;
+    int                 Count = -1;
+    ImWidgetsJobPtr<ImFlameGraphLayoutJob> Job;
+    ImFlameGraphLayout  Layout;
+    bool                LayoutReady = false;
+
+    // Label widths per name id for FontSize, -1 until measured
+    std::vector<float>  NameWidths;
+    float               FontSize = 0.0f;
+    float               EllipsisWidth = 0.0f;
+
+    std::vector<std::pair<int, int>> Stack; // (parent, depth) of the child lists still to lay out
+
+    float NameWidth(const ImFlameGraphNames& names, int name) {
+        if (FontSize != ImGui::GetFontSize()) {
+            FontSize = ImGui::GetFontSize();
+            EllipsisWidth = ImGui::CalcTextSize("..").x;
+            NameWidths.clear();
+        }
+        if ((int)NameWidths.size() < names.Size())
+            NameWidths.resize(names.Size(), -1.0f);
+        if (NameWidths[name] < 0.0f)
+            NameWidths[name] = ImGui::CalcTextSize(names.Get(name), names.GetEnd(name)).x;
+        return NameWidths[name];
+    }
+};
+
+void ImWidgets::FlameGraph(const char* label, const ImFlameGraphNode* nodes, int nodes_count, const ImFlameGraphNames& names, int nodes_version, ImFlameGraphFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    ImGuiID id = ImGui::GetID(label);
+
+    std::unordered_map<ImGuiID, ImFlameGraphState>& flameGraphStates = GetStatePool<ImFlameGraphState>(ImWidgetsContextSlot_FlameGraph);
+    ImFlameGraphState& st = flameGraphStates[id];
+    nodes_count = ImMax(nodes_count, 0);
+    // A layout cancelled while the graph was out of sight starts over
+    if (JobOutdated(id, st.Job.get(), nodes_version != st.Version || nodes_count != st.Count)) {
+        st.Job.reset(new ImFlameGraphLayoutJob());
+        st.Version = nodes_version;
+        st.Count = nodes_count;
+        st.LayoutReady = false;
+        ImFlameGraphLayoutJob* job = st.Job.get();
+        job->Start(id, [job, nodes, nodes_count]() { job->Layout.Build(nodes, nodes_count, job->Cancel); });
+    }
+    if (st.Job && st.Job->Done) {
+        st.Layout = std::move(st.Job->Layout);
+        st.Job.reset();
+        st.LayoutReady = true;
+    }
+
+    ImGui::PushID(label);
+    const float row_height = style.ImFlameGraphRowHeight > 0.0f ? style.ImFlameGraphRowHeight : ImGui::GetFrameHeight();
+    ImVec2 size = ImGui::CalcItemSize(style.ImFlameGraphSize, ImGui::CalcItemWidth(), ImMax(ImGui::GetContentRegionAvail().y, row_height * 8.0f));
+    ImGui::InvisibleButton("##flame", size);
+    const ImRect frame(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    const bool hovered = ImGui::IsItemHovered();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(frame.Min, frame.Max, GetColorU32(ImWidgetsCol_FlameGraphBg), ImGui::GetStyle().FrameRounding);
+    if (!st.LayoutReady) {
+        draw_list->AddText(ImVec2(frame.Min.x + ImGui::GetStyle().FramePadding.x, frame.Min.y + ImGui::GetStyle().FramePadding.y), ImGui::GetColorU32(ImGuiCol_TextDisabled), "Building...");
+        ImGui::PopID();
+        return;
+    }
+    const ImFlameGraphLayout& layout = st.Layout;
+
+    // Wheel zooms around the mouse, dragging pans both ways, double-click shows everything
+    ImGuiIO& io = ImGui::GetIO();
+    const bool inverted = (flags & ImFlameGraphFlags_Inverted) != 0;
+    const float content_height = (layout.MaxDepth + 1) * row_height;
+    if (st.Fit) {
+        st.ViewMin = 0.0;
+        st.ViewMax = ImMax(layout.Total, 1e-9);
+    }
+    double units_per_pixel = (st.ViewMax - st.ViewMin) / size.x;
+    if (!(flags & ImFlameGraphFlags_NoInteraction)) {
+        if (hovered) {
+            ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
+            if (io.MouseWheel != 0.0f) {
+                double anchor = st.ViewMin + (io.MousePos.x - frame.Min.x) * units_per_pixel;
+                double scale = io.MouseWheel > 0.0f ? 0.8 : 1.25;
+                st.ViewMin = anchor - (anchor - st.ViewMin) * scale;
+                st.ViewMax = anchor + (st.ViewMax - anchor) * scale;
+                st.Fit = false;
+            }
+            if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+                st.Fit = true;
+        }
+        if (ImGui::IsItemActive() && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)) {
+            st.ViewMin -= io.MouseDelta.x * units_per_pixel;
+            st.ViewMax -= io.MouseDelta.x * units_per_pixel;
+            st.ScrollY += inverted ? io.MouseDelta.y : -io.MouseDelta.y;
+            st.Fit = false;
+        }
+    }
+    st.ScrollY = ImClamp(st.ScrollY, 0.0f, ImMax(content_height - size.y, 0.0f));
+    units_per_pixel = (st.ViewMax - st.ViewMin) / size.x;
+    const double pixels_per_unit = 1.0 / units_per_pixel;
+    auto row_top = [&](int depth) { return inverted ? frame.Max.y - (depth + 1) * row_height + st.ScrollY : frame.Min.y + depth * row_height - st.ScrollY; };
+
+    // Lay out the visible part only: children are sorted by offset, so the first visible child is a binary search away
+    // and a run of sub-pixel children is merged by searching the first child starting one pixel later
+    const ImU32 col_merged = GetColorU32(ImWidgetsCol_FlameGraphMerged), col_text = GetColorU32(ImWidgetsCol_FlameGraphText);
+    const float padding = ImGui::GetStyle().FramePadding.x * 0.5f;
+    const float text_offset_y = (row_height - ImGui::GetFontSize()) * 0.5f;
+    const ImVec2 mouse = io.MousePos;
+    int hovered_node = -1, hovered_merged_count = 0;
+    double hovered_merged_total = 0.0;
+    auto node_start = [&](int k) { return layout.Start[layout.Children[k]]; };
+    auto node_end = [&](int k) { return layout.Start[layout.Children[k]] + ImMax(nodes[layout.Children[k]].Total, 0.0f); };
+
+    draw_list->PushClipRect(frame.Min, frame.Max, true);
+    st.Stack.clear();
+    st.Stack.push_back({ nodes_count, 0 });
+    while (!st.Stack.empty()) {
+        const int parent = st.Stack.back().first, depth = st.Stack.back().second;
+        st.Stack.pop_back();
+        const float y0 = row_top(depth);
+        if (inverted ? y0 + row_height < frame.Min.y : y0 > frame.Max.y)
+            continue;   // This row and every deeper one are out of view
+        const bool row_visible = y0 + row_height >= frame.Min.y && y0 <= frame.Max.y;
+        const bool row_hovered = hovered && mouse.y >= y0 && mouse.y < y0 + row_height;
+
+        const int* children = layout.Children.data();
+        int k = layout.ChildStart[parent];
+        const int k_end = layout.ChildStart[parent + 1];
+        k = (int)(std::upper_bound(children + k, children + k_end, st.ViewMin, [&](double v, int node) { return v < layout.Start[node] + ImMax(nodes[node].Total, 0.0f); }) - children);
+        while (k < k_end && node_start(k) < st.ViewMax) {
+            const int node = children[k];
+            const float x0 = (float)(frame.Min.x + (node_start(k) - st.ViewMin) * pixels_per_unit);
+            const float width = (float)(ImMax(nodes[node].Total, 0.0f) * pixels_per_unit);
+            if (width >= 1.0f) {
+                const float x1 = x0 + width;
+                if (row_visible) {
+                    const ImU32 col = ImGui::ColorConvertFloat4ToU32(ImLerp(style.ImFlameGraphColdColor, style.ImFlameGraphHotColor, (ImHashData(&nodes[node].Name, sizeof(int)) & 0xFF) / 255.0f));
+                    draw_list->AddRectFilled(ImVec2(ImMax(x0, frame.Min.x), y0), ImVec2(ImMin(x1, frame.Max.x) - (width >= 3.0f ? 1.0f : 0.0f), y0 + row_height - 1.0f), col);
+                    const float label_x0 = ImMax(x0, frame.Min.x) + padding, label_width = ImMin(x1, frame.Max.x) - padding - label_x0;
+                    if (label_width > st.EllipsisWidth) {
+                        const int name = nodes[node].Name;
+                        DrawTextWithEllipsis(draw_list, ImVec2(label_x0, y0 + text_offset_y), col_text, names.Get(name), names.GetEnd(name), label_width, st.NameWidth(names, name), st.EllipsisWidth);
+                    }
+                }
+                if (row_hovered && mouse.x >= x0 && mouse.x < x1)
+                    hovered_node = node;
+                if (layout.ChildStart[node] != layout.ChildStart[node + 1])
+                    st.Stack.push_back({ node, depth + 1 });
+                k++;
+            }
+            else {
+                // Every child starting within the next pixel is narrower than a pixel, except maybe the last one
+                const double run_start = node_start(k);
+                int run_end = (int)(std::lower_bound(children + k + 1, children + k_end, run_start + units_per_pixel, [&](int n, double v) { return layout.Start[n] < v; }) - children);
+                if (run_end - 1 > k && nodes[children[run_end - 1]].Total * pixels_per_unit >= 1.0f)
+                    run_end--;
+                const float x1 = ImMax((float)(frame.Min.x + (node_end(run_end - 1) - st.ViewMin) * pixels_per_unit), x0 + 1.0f);
+                if (row_visible)
+                    draw_list->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y0 + row_height - 1.0f), col_merged);
+                if (row_hovered && mouse.x >= x0 && mouse.x < x1) {
+                    hovered_merged_count = run_end - k;
+                    hovered_merged_total = node_end(run_end - 1) - run_start;
+                }
+                k = run_end;
+            }
+        }
+    }
+    draw_list->PopClipRect();
+
+    if (hovered_node >= 0) {
+        if (!(flags & ImFlameGraphFlags_NoInteraction) && ImGui::IsItemDeactivated() && !ImGui::IsMouseDragPastThreshold(ImGuiMouseButton_Left)) {
+            st.ViewMin = layout.Start[hovered_node];
+            st.ViewMax = layout.Start[hovered_node] + ImMax((double)nodes[hovered_node].Total, 1e-9);
+            st.Fit = false;
+        }
+        if (!(flags & ImFlameGraphFlags_NoTooltip)) {
+            const ImFlameGraphNode& n = nodes[hovered_node];
+            ImGui::BeginTooltip();
+            ImGui::TextUnformatted(names.Get(n.Name), names.GetEnd(n.Name));
+            ImGui::Text("Total: %g (%.2f%%)", n.Total, layout.Total > 0.0 ? n.Total / layout.Total * 100.0 : 0.0);
+            ImGui::Text("Self: %g", n.Self);
+            ImGui::EndTooltip();
+        }
+    }
+    else if (hovered_merged_count > 0 && !(flags & ImFlameGraphFlags_NoTooltip)) {
+        ImGui::SetTooltip("%d nodes narrower than a pixel\nTotal: %g", hovered_merged_count, hovered_merged_total);
+    }
+    ImGui::PopID();
+}
+
+/*
+    TIMELINE
+*/
+
+// Days since 1970-01-01 of a proleptic Gregorian date, month 1-12
+static ImS64 DaysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const ImS64 era = (year >= 0 ? year : year - 399) / 400;
+    const int year_of_era = (int)(year - era * 400);
+    const int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+static void CivilFromDays(ImS64 days, int& year, int& month, int& day) {
+    days += 719468;
+    const ImS64 era = (days >= 0 ? days : days - 146096) / 146097;
+    const int day_of_era = (int)(days - era * 146097);
+    const int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const int mp = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = (int)(year_of_era + era * 400) + (month <= 2);
+}
+
+double ImWidgets::DateToTime(int day, int month, int year) {
+    return (double)DaysFromCivil(year, month, day) * 86400.0;
+}
+
+void ImWidgets::TimeToDate(double time, int& day, int& month, int& year) {
+    CivilFromDays((ImS64)floor(time / 86400.0), year, month, day);
+}
+
+// Axis and tooltip text for a time. Date axes print the Calendar's "day / month / year" for whole days and the time of
+// day below that, with as many decimals as 'step' needs (0 = milliseconds).
+static void FormatTimelineTime(char* buf, int buf_size, double time, double step, bool date_axis) {
+    if (!date_axis) {
+        ImFormatString(buf, buf_size, "%g", time);
+        return;
+    }
+    const double days = floor(time / 86400.0);
+    int day, month, year;
+    CivilFromDays((ImS64)days, year, month, day);
+    const double seconds = time - days * 86400.0;
+    const int h = (int)(seconds / 3600.0), m = (int)(seconds / 60.0) % 60, sec = (int)seconds % 60;
+    if (step >= 86400.0)
+        ImFormatString(buf, buf_size, "%d / %d / %d", day, month, year);
+    else if (step >= 1.0)
+        ImFormatString(buf, buf_size, "%02d:%02d:%02d", h, m, sec);
+    else if (step > 0.0)
+        ImFormatString(buf, buf_size, "%02d:%02d:%0*.*f", h, m, step >= 0.1 ? 4 : step >= 0.01 ? 5 : 6, step >= 0.1 ? 1 : step >= 0.01 ? 2 : 3, fmod(seconds, 60.0));
+    else
+        ImFormatString(buf, buf_size, "%d / %d / %d %02d:%02d:%06.3f", day, month, year, h, m, fmod(seconds, 60.0));
+}
+
+// Tick step of at least 'min_step': 1-2-5 decades, or calendar-friendly units on date axes
+static double TimelineTickStep(double min_step, bool date_axis) {
+    static const double date_steps[] = { 1, 2, 5, 10, 15, 30, 60, 120, 300, 600, 900, 1800, 3600, 7200, 10800, 21600, 43200,
+                                         86400, 2 * 86400, 7 * 86400, 14 * 86400, 28 * 86400, 91 * 86400, 365 * 86400 };
+    if (date_axis && min_step >= 0.5)
+        for (double step : date_steps)
+            if (step >= min_step)
+                return step;
+    const double decade = pow(10.0, floor(log10(min_step)));
+    const double step = min_step <= decade ? decade : min_step <= 2.0 * decade ? 2.0 * decade : min_step <= 5.0 * decade ? 5.0 * decade : 10.0 * decade;
+    return date_axis && step > 365 * 86400.0 ? ceil(step / (365 * 86400.0)) * 365 * 86400.0 : step;
+}
+
+// Spans of one lane sorted by start. Per bucket of 16 spans, the max end and the max length are kept in implicit binary
+// trees, so the spans overlapping a time range (or longer than a pixel) are found in O(log n) each without a
+// pointer-based interval tree. Starts and Ends are copied in that order so searches walk contiguous arrays instead of
+// chasing Order into the spans, and BinPrefix counts span starts per time bin to shade zoomed-out views without
+// touching the spans at all.
+struct ImTimelineLane {
+    static constexpr int BucketSize = 16;
+    std::vector<int>    Order;
+    std::vector<double> Starts;
+    std::vector<double> Ends;
+    std::vector<double> MaxEnd;         // Leaves at [Leaves, 2 * Leaves)
+    std::vector<double> MaxLength;
+    int                 Leaves = 0;
+    std::vector<int>    BinPrefix;      // Spans starting before each bin, Bins + 1 entries
+    int                 Bins = 0;
+    double              BinMin = 0.0;
+    double              BinWidth = 0.0;
+
+    void Build(const ImTimelineSpan* spans, double time_min, double time_max) {
+        const int n = (int)Order.size();
+        Starts.resize(n);
+        Ends.resize(n);
+        Leaves = 1;
+        while (Leaves * BucketSize < n)
+            Leaves *= 2;
+        MaxEnd.assign((size_t)Leaves * 2, -DBL_MAX);
+        MaxLength.assign((size_t)Leaves * 2, -DBL_MAX);
+        for (int k = 0; k < n; k++) {
+            Starts[k] = spans[Order[k]].Start;
+            Ends[k] = spans[Order[k]].End;
+            const int leaf = Leaves + k / BucketSize;
+            MaxEnd[leaf] = ImMax(MaxEnd[leaf], Ends[k]);
+            MaxLength[leaf] = ImMax(MaxLength[leaf], Ends[k] - Starts[k]);
+        }
+        for (int i = Leaves - 1; i > 0; i--) {
+            MaxEnd[i] = ImMax(MaxEnd[2 * i], MaxEnd[2 * i + 1]);
+            MaxLength[i] = ImMax(MaxLength[2 * i], MaxLength[2 * i + 1]);
+        }
+
+        // About 4 spans per bin on average
+        Bins = 1;
+        while (Bins * 4 < n)
+            Bins *= 2;
+        BinMin = time_min;
+        BinWidth = ImMax(time_max - time_min, 1e-9) / Bins;
+        BinPrefix.assign((size_t)Bins + 1, 0);
+        for (int k = 0; k < n; k++)
+            BinPrefix[BinIndex(Starts[k]) + 1]++;
+        for (int b = 0; b < Bins; b++)
+            BinPrefix[b + 1] += BinPrefix[b];
+    }
+
+    int BinIndex(double t) const { return ImClamp((int)((t - BinMin) / BinWidth), 0, Bins - 1); }
+
+    // Spans starting in [t0, t1), rounded to bins
+    int CountStarts(double t0, double t1) const {
+        if (t1 <= BinMin || t0 >= BinMin + Bins * BinWidth)
+            return 0;
+        const int b0 = t0 <= BinMin ? 0 : (int)ImMin((t0 - BinMin) / BinWidth, (double)Bins);
+        const int b1 = (int)ImMin((t1 - BinMin) / BinWidth, (double)Bins);
+        return BinPrefix[b1] - BinPrefix[b0];
+    }
+
+    // First bucket >= bucket whose tree value is above t, or Leaves
+    int FirstBucketAbove(const std::vector<double>& tree, int bucket, double t) const {
+        if (bucket >= Leaves)
+            return Leaves;
+        int i = bucket + Leaves;
+        while (!(tree[i] > t)) {
+            while (i & 1)
+                i >>= 1;
+            if (i == 0)
+                return Leaves;
+            i++;
+        }
+        while (i < Leaves)
+            i = tree[2 * i] > t ? 2 * i : 2 * i + 1;
+        return i - Leaves;
+    }
+
+    // First k in [k, k_end) matching 'pred', visiting only the buckets whose tree value is above t
+    template<typename PRED>
+    int FindInBuckets(const std::vector<double>& tree, int k, int k_end, double t, PRED pred) const {
+        while (k < k_end) {
+            if (k % BucketSize == 0 || !(tree[Leaves + k / BucketSize] > t)) {
+                k = ImMax(k, FirstBucketAbove(tree, k / BucketSize + (k % BucketSize != 0), t) * BucketSize);
+                if (k >= k_end)
+                    break;
+            }
+            if (pred(k))
+                return k;
+            k++;
+        }
+        return k_end;
+    }
+
+    // Calls fn(k) for every k in [k, k_end) in a bucket whose leaf is above t. The leaves are scanned in order: when
+    // the range holds many matches, streaming through them is several times cheaper than repeated tree descents.
+    template<typename FN>
+    void ForEachInBuckets(const std::vector<double>& tree, int k, int k_end, double t, FN fn) const {
+        for (int bucket = k / BucketSize; bucket * BucketSize < k_end; bucket++)
+            if (tree[Leaves + bucket] > t)
+                for (int i = ImMax(bucket * BucketSize, k); i < ImMin((bucket + 1) * BucketSize, k_end); i++)
+                    fn(i);
+    }
+
+    int FindEndingAfter(int k, int k_end, double t) const { return FindInBuckets(MaxEnd, k, k_end, t, [&](int i) { return Ends[i] > t; }); }
+
+    // First k in [k, k_end) whose span starts at or after t, galloping from k since runs are usually short
+    int LowerBoundStart(int k, int k_end, double t) const {
+        int step = 1;
+        while (k + step < k_end && Starts[k + step] < t) {
+            k += step;
+            step *= 2;
+        }
+        return (int)(std::lower_bound(Starts.begin() + k, Starts.begin() + ImMin(k + step, k_end), t) - Starts.begin());
+    }
+};
+
+struct ImTimelineIndex {
+    std::vector<ImTimelineLane> Lanes;
+    double              Min = 0.0;
+    double              Max = 1.0;
+
+    void Build(const ImTimelineSpan* spans, int n, const std::atomic<bool>& cancel) {
+        int lanes_count = 0;
+        Min = DBL_MAX;
+        Max = -DBL_MAX;
+        for (int i = 0; i < n; i++) {
+            if (spans[i].Lane < 0)
+                continue;
+            lanes_count = ImMax(lanes_count, spans[i].Lane + 1);
+            Min = ImMin(Min, spans[i].Start);
+            Max = ImMax(Max, spans[i].End);
+        }
+        if (Min > Max) {
+            Min = 0.0;
+            Max = 1.0;
+        }
+        Lanes.resize(lanes_count);
+        for (int i = 0; i < n; i++)
+            if (spans[i].Lane >= 0)
+                Lanes[spans[i].Lane].Order.push_back(i);
+        for (ImTimelineLane& lane : Lanes) {
+            if (cancel)
+                return;
+            ParallelSortIndex(lane.Order, [spans](int a, int b) { return spans[a].Start < spans[b].Start; }, cancel);
+            lane.Build(spans, Min, Max);
+        }
+    }
+};
+
+struct ImTimelineIndexJob : ImWidgetsJob {
+    ImTimelineIndex     Index;
+};
+
+struct ImTimelineLabel {
+    ImVec2      Pos;
+    float       Width;
+    const char* Text;
+};
+
+struct ImTimelineState {
+    double              ViewMin = 0.0;
+    double              ViewMax = 0.0;
+    bool                Fit = true;
+    float               ScrollY = 0.0f;
+    int                 Version = -1;
+    int                 Count = -1;
+    ImWidgetsJobPtr<ImTimelineIndexJob> Job;
+    ImTimelineIndex     Index;
+    bool                IndexReady = false;
+    std::vector<ImTimelineLabel> Labels;    // Drawn after the quads of the frame
+};
+
+static ImTimelineState& GetTimelineState(ImGuiID id) {
+    return GetStatePool<ImTimelineState>(ImWidgetsContextSlot_Timeline)[id];
+}
+
+void ImWidgets::TimelineSetView(const char* label, double time_min, double time_max) {
+    ImTimelineState& st = GetTimelineState(ImGui::GetID(label));
+    st.ViewMin = time_min;
+    st.ViewMax = ImMax(time_max, time_min + 1e-9);
+    st.Fit = false;
+}
+
+void ImWidgets::Timeline(const char* label, const ImTimelineSpan* spans, int spans_count, int spans_version, ImTimelineFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    const ImGuiID id = ImGui::GetID(label);
+    ImTimelineState& st = GetTimelineState(id);
+    spans_count = ImMax(spans_count, 0);
+    // An index cancelled while the timeline was out of sight starts over
+    if (JobOutdated(id, st.Job.get(), spans_version != st.Version || spans_count != st.Count)) {
+        st.Job.reset(new ImTimelineIndexJob());
+        st.Version = spans_version;
+        st.Count = spans_count;
+        st.IndexReady = false;
+        ImTimelineIndexJob* job = st.Job.get();
+        job->Start(id, [job, spans, spans_count]() { job->Index.Build(spans, spans_count, job->Cancel); });
+    }
+    if (st.Job && st.Job->Done) {
+        st.Index = std::move(st.Job->Index);
+        st.Job.reset();
+        st.IndexReady = true;
+    }
+
+    ImGui::PushID(label);
+    const float lane_height = style.ImTimelineLaneHeight > 0.0f ? style.ImTimelineLaneHeight : ImGui::GetFrameHeight();
+    const float axis_height = ImGui::GetFrameHeight();
+    ImVec2 size = ImGui::CalcItemSize(style.ImTimelineSize, ImGui::CalcItemWidth(), ImMax(ImGui::GetContentRegionAvail().y, axis_height + lane_height * 4.0f));
+    ImGui::InvisibleButton("##timeline", size);
+    const ImRect frame(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    const bool hovered = ImGui::IsItemHovered();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(frame.Min, frame.Max, GetColorU32(ImWidgetsCol_TimelineBg), ImGui::GetStyle().FrameRounding);
+    if (!st.IndexReady) {
+        draw_list->AddText(ImVec2(frame.Min.x + ImGui::GetStyle().FramePadding.x, frame.Min.y + ImGui::GetStyle().FramePadding.y), ImGui::GetColorU32(ImGuiCol_TextDisabled), "Indexing...");
+        ImGui::PopID();
+        return;
+    }
+    const ImTimelineIndex& index = st.Index;
+
+    // Wheel zooms around the mouse, dragging pans time and scrolls lanes, double-click shows everything
+    ImGuiIO& io = ImGui::GetIO();
+    if (st.Fit) {
+        st.ViewMin = index.Min;
+        st.ViewMax = ImMax(index.Max, index.Min + 1e-9);
+    }
+    double units_per_pixel = (st.ViewMax - st.ViewMin) / size.x;
+    if (!(flags & ImTimelineFlags_NoInteraction)) {
+        if (hovered) {
+            ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
+            if (io.MouseWheel != 0.0f) {
+                double anchor = st.ViewMin + (io.MousePos.x - frame.Min.x) * units_per_pixel;
+                double scale = io.MouseWheel > 0.0f ? 0.8 : 1.25;
+                st.ViewMin = anchor - (anchor - st.ViewMin) * scale;
+                st.ViewMax = anchor + (st.ViewMax - anchor) * scale;
+                st.Fit = false;
+            }
+            if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+                st.Fit = true;
+        }
+        if (ImGui::IsItemActive() && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)) {
+            st.ViewMin -= io.MouseDelta.x * units_per_pixel;
+            st.ViewMax -= io.MouseDelta.x * units_per_pixel;
+            st.ScrollY -= io.MouseDelta.y;
+            st.Fit = false;
+        }
+    }
+    // Don't zoom past what doubles can tell apart at this distance from 0
+    const double min_range = ImMax(ImMax(fabs(st.ViewMin), fabs(st.ViewMax)) * DBL_EPSILON * 16.0 * size.x, 1e-12);
+    if (st.ViewMax - st.ViewMin < min_range) {
+        const double center = (st.ViewMin + st.ViewMax) * 0.5;
+        st.ViewMin = center - min_range * 0.5;
+        st.ViewMax = center + min_range * 0.5;
+    }
+    const float lanes_height = size.y - axis_height;
+    st.ScrollY = ImClamp(st.ScrollY, 0.0f, ImMax((int)index.Lanes.size() * lane_height - lanes_height, 0.0f));
+    units_per_pixel = (st.ViewMax - st.ViewMin) / size.x;
+    const double pixels_per_unit = 1.0 / units_per_pixel;
+    const bool date_axis = (flags & ImTimelineFlags_DateAxis) != 0;
+
+    // Axis with a tick every ~100 pixels
+    const ImU32 col_axis = GetColorU32(ImWidgetsCol_TimelineAxis), col_text = GetColorU32(ImWidgetsCol_TimelineText);
+    const double step = TimelineTickStep(units_per_pixel * 100.0, date_axis);
+    char buf[64];
+    draw_list->PushClipRect(frame.Min, frame.Max, true);
+    const double first_tick = ceil(st.ViewMin / step);
+    for (int i = 0; i < (int)(size.x / 50.0f) + 2; i++) {
+        const double tick = (first_tick + i) * step;
+        if (tick > st.ViewMax)
+            break;
+        const float x = IM_TRUNC((float)(frame.Min.x + (tick - st.ViewMin) * pixels_per_unit));
+        FormatTimelineTime(buf, IM_ARRAYSIZE(buf), tick, step, date_axis);
+        draw_list->AddLine(ImVec2(x, frame.Min.y + axis_height * 0.6f), ImVec2(x, frame.Max.y), col_axis);
+        draw_list->AddText(ImVec2(x + 3.0f, frame.Min.y + ImGui::GetStyle().FramePadding.y * 0.5f), col_text, buf);
+    }
+    draw_list->PopClipRect();
+
+    // Visible lanes: spans overlapping the view come from the lane index, every span starting in a pixel column where
+    // a sub-pixel span starts is merged into one density block, except those reaching past the next pixel
+    const ImVec2 lanes_min(frame.Min.x, frame.Min.y + axis_height);
+    const ImU32 col_span = GetColorU32(ImWidgetsCol_TimelineSpan);
+    auto density_color = [&](int shade) { ImVec4 col = style.ImTimelineDensityColor; col.w *= shade / 20.0f; return ImGui::ColorConvertFloat4ToU32(col); };
+    const float padding = ImGui::GetStyle().FramePadding.x * 0.5f;
+    const float ellipsis_width = ImGui::CalcTextSize("..").x;
+    const ImVec2 mouse = io.MousePos;
+    int hovered_span = -1, hovered_density = 0;
+    st.Labels.clear();
+    draw_list->PushClipRect(lanes_min, frame.Max, true);
+    {
+        const int first_lane = (int)(st.ScrollY / lane_height);
+        const int last_lane = ImMin((int)((st.ScrollY + lanes_height) / lane_height), (int)index.Lanes.size() - 1);
+        ImQuadWriter writer(draw_list, (last_lane - first_lane + 1) * 16);
+        for (int lane_index = first_lane; lane_index <= last_lane; lane_index++) {
+            const ImTimelineLane& lane = index.Lanes[lane_index];
+            const float y0 = lanes_min.y + lane_index * lane_height - st.ScrollY, y1 = y0 + lane_height - 1.0f;
+            const bool lane_hovered = hovered && mouse.y >= y0 && mouse.y < y1 + 1.0f;
+            auto draw_span = [&](int i) {
+                const ImTimelineSpan& span = spans[i];
+                const float x0 = ImMax((float)(frame.Min.x + (span.Start - st.ViewMin) * pixels_per_unit), frame.Min.x - 1.0f);
+                const float x1 = ImMin((float)(frame.Min.x + (span.End - st.ViewMin) * pixels_per_unit), frame.Max.x + 1.0f);
+                writer.AddRect(ImVec2(x0, y0), ImVec2(ImMax(x1 - (x1 - x0 >= 3.0f ? 1.0f : 0.0f), x0 + 1.0f), y1), span.Color ? span.Color : col_span);
+                const float label_x0 = ImMax(x0, frame.Min.x) + padding;
+                if (span.Label && x1 - padding - label_x0 > ellipsis_width)
+                    st.Labels.push_back({ ImVec2(label_x0, y0 + (lane_height - ImGui::GetFontSize()) * 0.5f), x1 - padding - label_x0, span.Label });
+                if (lane_hovered && mouse.x >= x0 && mouse.x < ImMax(x1, x0 + 1.0f))
+                    hovered_span = i;
+            };
+
+            const int k_end = lane.LowerBoundStart(0, (int)lane.Order.size(), std::nextafter(st.ViewMax, DBL_MAX));
+            int k = lane.FindEndingAfter(0, k_end, st.ViewMin);
+            if (lane.BinWidth <= units_per_pixel && k_end - k > size.x * 2.0f) {
+                // Zoomed out: shade columns from the start counts, equal neighbours as one quad, then draw the spans
+                // longer than a pixel on top
+                int run_first = 0, run_shade = 0;
+                for (int column = 0; column <= (int)size.x; column++) {
+                    const int count = column < (int)size.x ? lane.CountStarts(st.ViewMin + column * units_per_pixel, st.ViewMin + (column + 1) * units_per_pixel) : 0;
+                    const int shade = count > 0 ? ImMin(7 + (int)log2f((float)count) * 2, 20) : 0;
+                    if (lane_hovered && (int)(mouse.x - frame.Min.x) == column)
+                        hovered_density = count;
+                    if (shade == run_shade)
+                        continue;
+                    if (run_shade > 0)
+                        writer.AddRect(ImVec2(frame.Min.x + run_first, y0), ImVec2(frame.Min.x + column, y1), density_color(run_shade));
+                    run_first = column;
+                    run_shade = shade;
+                }
+                lane.ForEachInBuckets(lane.MaxLength, k, k_end, units_per_pixel, [&](int i) {
+                    if (lane.Ends[i] - lane.Starts[i] > units_per_pixel && lane.Ends[i] > st.ViewMin)
+                        draw_span(lane.Order[i]);
+                });
+                continue;
+            }
+
+            // Zoomed in: walk the overlapping spans, merging the ones starting in the same pixel column
+            while (k < k_end) {
+                if ((lane.Ends[k] - lane.Starts[k]) * pixels_per_unit >= 1.0) {
+                    draw_span(lane.Order[k]);
+                    k = lane.FindEndingAfter(k + 1, k_end, st.ViewMin);
+                    continue;
+                }
+                const double column = floor((lane.Starts[k] - st.ViewMin) * pixels_per_unit);
+                const double column_end = st.ViewMin + (column + 1.0) * units_per_pixel;
+                const int run_end = ImMax(lane.LowerBoundStart(k + 1, k_end, column_end), k + 1);
+                const float x = (float)(frame.Min.x + column);
+                const int count = run_end - k;
+                writer.AddRect(ImVec2(x, y0), ImVec2(x + 1.0f, y1), density_color(ImMin(7 + (int)log2f((float)count) * 2, 20)));
+                if (lane_hovered && mouse.x >= x && mouse.x < x + 1.0f)
+                    hovered_density = count;
+                for (int w = lane.FindEndingAfter(k, run_end, column_end + units_per_pixel); w < run_end; w = lane.FindEndingAfter(w + 1, run_end, column_end + units_per_pixel))
+                    draw_span(lane.Order[w]);
+                k = lane.FindEndingAfter(run_end, k_end, st.ViewMin);
+            }
+        }
+    }
+    for (const ImTimelineLabel& l : st.Labels)
+        DrawTextWithEllipsis(draw_list, l.Pos, col_text, l.Text, nullptr, l.Width, -1.0f, ellipsis_width);
+    draw_list->PopClipRect();
+
+    if (!(flags & ImTimelineFlags_NoTooltip)) {
+        if (hovered_span >= 0) {
+            const ImTimelineSpan& span = spans[hovered_span];
+            ImGui::BeginTooltip();
+            if (span.Label)
+                ImGui::TextUnformatted(span.Label);
+            FormatTimelineTime(buf, IM_ARRAYSIZE(buf), span.Start, 0.0, date_axis);
+            ImGui::Text("Start: %s", buf);
+            FormatTimelineTime(buf, IM_ARRAYSIZE(buf), span.End, 0.0, date_axis);
+            ImGui::Text("End: %s", buf);
+            ImGui::Text("Duration: %g", span.End - span.Start);
+            ImGui::Text("Lane: %d", span.Lane);
+            ImGui::EndTooltip();
+        }
+        else if (hovered_density > 0) {
+            ImGui::SetTooltip("%d spans narrower than a pixel", hovered_density);
+        }
+    }
+    ImGui::PopID();
+}
+
+/*
+    HEX VIEWER
+*/
+
+// Writes 16 bytes as "XX XX .. XX " (48 chars) to hex, and as printable ASCII or '.' (16 chars) to ascii
+static void HexEncodeRow(const unsigned char* src, char* hex, char* ascii) {
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i v = _mm_loadu_si128((const __m128i*)src);
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_set1_epi8('0'), nine = _mm_set1_epi8(9), letter = _mm_set1_epi8('A' - '0' - 10);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask);
+    const __m128i lo = _mm_and_si128(v, nibble_mask);
+    const __m128i hi_digits = _mm_add_epi8(_mm_add_epi8(hi, zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), letter));
+    const __m128i lo_digits = _mm_add_epi8(_mm_add_epi8(lo, zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), letter));
+    const __m128i pairs0 = _mm_unpacklo_epi8(hi_digits, lo_digits);     // Bytes 0-7
+    const __m128i pairs1 = _mm_unpackhi_epi8(hi_digits, lo_digits);     // Bytes 8-15
+#ifdef __SSSE3__
+    // Spread the pairs over 3 vectors, a space after each
+    const char X = -128;
+    const __m128i out0 = _mm_or_si128(_mm_shuffle_epi8(pairs0, _mm_setr_epi8(0, 1, X, 2, 3, X, 4, 5, X, 6, 7, X, 8, 9, X, 10)),
+        _mm_setr_epi8(0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0));
+    const __m128i out1 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(pairs0, _mm_setr_epi8(11, X, 12, 13, X, 14, 15, X, X, X, X, X, X, X, X, X)),
+        _mm_shuffle_epi8(pairs1, _mm_setr_epi8(X, X, X, X, X, X, X, X, 0, 1, X, 2, 3, X, 4, 5))),
+        _mm_setr_epi8(0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0));
+    const __m128i out2 = _mm_or_si128(_mm_shuffle_epi8(pairs1, _mm_setr_epi8(X, 6, 7, X, 8, 9, X, 10, 11, X, 12, 13, X, 14, 15, X)),
+        _mm_setr_epi8(' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' '));
+    _mm_storeu_si128((__m128i*)hex, out0);
+    _mm_storeu_si128((__m128i*)(hex + 16), out1);
+    _mm_storeu_si128((__m128i*)(hex + 32), out2);
+#else
+    char digits[32];
+    _mm_storeu_si128((__m128i*)digits, pairs0);
+    _mm_storeu_si128((__m128i*)(digits + 16), pairs1);
+    for (int i = 0; i < 16; i++) {
+        hex[i * 3 + 0] = digits[i * 2 + 0];
+        hex[i * 3 + 1] = digits[i * 2 + 1];
+        hex[i * 3 + 2] = ' ';
+    }
+#endif
+    // Signed compares: bytes >= 0x80 are negative and fail the first one
+    const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F)), _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F)));
+    _mm_storeu_si128((__m128i*)ascii, _mm_or_si128(_mm_and_si128(printable, v), _mm_andnot_si128(printable, _mm_set1_epi8('.'))));
+#else
+    static const char digits[] = "0123456789ABCDEF";
+    for (int i = 0; i < 16; i++) {
+        hex[i * 3 + 0] = digits[src[i] >> 4];
+        hex[i * 3 + 1] = digits[src[i] & 15];
+        hex[i * 3 + 2] = ' ';
+        ascii[i] = (src[i] >= 0x20 && src[i] < 0x7F) ? (char)src[i] : '.';
+    }
+#endif
+}
+
+// Parses hex bytes ("DE AD BE EF", spaces optional) or a quoted "text", returns false if malformed
+static bool ParseHexPattern(const char* query, std::string& out) {
+    out.clear();
+    while (*query == ' ')
+        query++;
+    if (*query == '"') {
+        const char* end = strchr(query + 1, '"');
+        out.assign(query + 1, end ? end : query + strlen(query));
+        return !out.empty();
+    }
+    int nibbles = 0, byte = 0;
+    for (const char* p = query; *p; p++) {
+        int v;
+        if (*p >= '0' && *p <= '9') v = *p - '0';
+        else if (*p >= 'a' && *p <= 'f') v = *p - 'a' + 10;
+        else if (*p >= 'A' && *p <= 'F') v = *p - 'A' + 10;
+        else if (*p == ' ' && (nibbles & 1) == 0) continue;
+        else return false;
+        byte = (byte << 4) | v;
+        if (++nibbles % 2 == 0)
+            out.push_back((char)byte);
+    }
+    return nibbles > 0 && (nibbles & 1) == 0;
+}
+
+struct ImHexViewerState {
+    static const int    RowBytes = 16;
+    static const int    RowChars = 16 + RowBytes * 3 + RowBytes;    // Address, hex, ASCII
+
+    // Files are read with ImFile::Read() rather than mapped, so one truncated while shown can't raise SIGBUS
+    std::string         Path;
+    ImFile              File;
+    bool                Failed = false;
+    const char*         Data = nullptr;     // Set when viewing memory
+    ImU64               Size = 0;
+    bool                Shrunk = false;     // A read came short, Size is queried again next frame
+
+    ImS64               ScrollRow = 0;
+    bool                ScrollToCursor = false;
+    bool                HasSelection = false;
+    ImU64               SelAnchor = 0;
+    ImU64               SelCursor = 0;
+
+    // Find bar
+    std::unique_ptr<ImTextSearch> Search;
+    std::string         Pattern;
+    char                Query[256] = "";
+    bool                QueryInvalid = false;
+    ImU64               SearchCursor = 0;
+
+    ~ImHexViewerState() { Search.reset(); }
+
+    void Reset() {
+        Search.reset();
+        QueryInvalid = false;
+        Query[0] = 0;
+        ScrollRow = 0;
+        HasSelection = false;
+        Shrunk = false;
+        SelAnchor = SelCursor = SearchCursor = 0;
+    }
+
+    void Open(const char* path) {
+        Reset();
+        Path = path;
+        Failed = !File.Open(path);
+        Data = nullptr;
+        Size = Failed ? 0 : File.QueryFileSize();
+    }
+
+    void SetData(const char* data, ImU64 size) {
+        Reset();
+        Path.clear();
+        File.Close();
+        Failed = false;
+        Data = data;
+        Size = data ? size : 0;
+    }
+
+    // Copies [offset, offset + size) to dst, bytes a file no longer has read as zeros
+    void Read(ImU64 offset, void* dst, size_t size) {
+        size_t length = 0;
+        if (Data) {
+            length = size;
+            memcpy(dst, Data + offset, size);
+        } else if (File.IsOpen()) {
+            length = File.Read(offset, dst, size);
+        }
+        if (length < size) {
+            memset((char*)dst + length, 0, size - length);
+            Shrunk = true;
+        }
+    }
+
+    ImU64 RowCount() const { return (Size + RowBytes - 1) / RowBytes; }
+    ImU64 SelectionMin() const { return ImMin(SelAnchor, SelCursor); }
+    ImU64 SelectionMax() const { return ImMax(SelAnchor, SelCursor); }
+};
+
+static ImHexViewerState& GetHexViewerState(ImGuiID id) {
+    return GetStatePool<ImHexViewerState>(ImWidgetsContextSlot_HexViewer)[id];
+}
+
+static void HexViewerEx(ImHexViewerState& st, ImHexViewerFlags flags) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    const int row_bytes = ImHexViewerState::RowBytes;
+
+    if ((flags & ImHexViewerFlags_Search) && !st.Failed) {
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16.0f);
+        bool changed = ImGui::InputTextWithHint("##find", "Find bytes or \"text\"", st.Query, IM_ARRAYSIZE(st.Query));
+        bool next = ImGui::IsItemFocused() && ImGui::IsKeyPressed(ImGuiKey_Enter);
+        ImGui::SameLine();
+        bool prev = ImGui::Button("<");
+        ImGui::SameLine();
+        next |= ImGui::Button(">");
+        ImGui::SameLine();
+
+        // A search cancelled while the viewer was out of sight starts over
+        const ImGuiID owner = ImGui::GetID("##find");
+        KeepTaskOwnerAlive(owner);
+        if (changed || (st.Search && st.Search->Cancel)) {
+            st.Search.reset();
+            st.QueryInvalid = false;
+            if (st.Query[0]) {
+                st.QueryInvalid = !ParseHexPattern(st.Query, st.Pattern);
+                if (!st.QueryInvalid) {
+                    st.Search.reset(new ImTextSearch());
+                    st.Search->Start(owner, st.Pattern, false, st.Data ? nullptr : &st.File, st.Data, st.Size);
+                }
+            }
+        }
+
+        ImTextSearch* search = st.Search.get();
+        ImU64 match = 0;
+        if (search && (prev || next) && search->FindNext(st.SearchCursor, prev, &match)) {
+            st.SearchCursor = match;
+            st.HasSelection = true;
+            st.SelAnchor = match;
+            st.SelCursor = match + st.Pattern.size() - 1;
+            st.ScrollToCursor = true;
+        }
+
+        if (st.QueryInvalid)
+            ImGui::TextColored(style.ImHexViewerErrorColor, "Invalid pattern");
+        else if (search && !search->IsDone())
+            ImWidgets::ProgressBar("##progress", 0.0f, 100.0f, search->Progress() * 100.0f, ImProgressBarFlags_PercentageLabel);
+        else if (search)
+            ImGui::Text("%llu matches", (unsigned long long)search->MatchCount.load());
+        else
+            ImGui::NewLine();
+    }
+
+    if (st.Failed) {
+        ImGui::TextColored(style.ImHexViewerErrorColor, "Unable to open '%s'", st.Path.c_str());
+        return;
+    }
+    if (st.Shrunk) {
+        st.Size = ImMin(st.Size, st.File.QueryFileSize());
+        st.Shrunk = false;
+    }
+
+    if (st.Size == 0)
+        st.HasSelection = false;
+    st.SelAnchor = ImMin(st.SelAnchor, st.Size ? st.Size - 1 : 0);
+    st.SelCursor = ImMin(st.SelCursor, st.Size ? st.Size - 1 : 0);
+
+    // Columns assume a monospace font, like the default one
+    const ImGuiStyle& imgui_style = ImGui::GetStyle();
+    const float line_height = ImGui::GetTextLineHeight();
+    const float char_width = ImGui::CalcTextSize("0").x;
+    const float scrollbar_width = imgui_style.ScrollbarSize;
+    const bool show_ascii = !(flags & ImHexViewerFlags_NoAscii);
+    int address_digits = 8;
+    while (address_digits < 16 && st.Size && ((st.Size - 1) >> (address_digits * 4)) != 0)
+        address_digits++;
+    const float content_width = (address_digits + 2 + row_bytes * 3 + 1 + (show_ascii ? 1 + row_bytes : 0)) * char_width;
+    ImVec2 size = ImGui::CalcItemSize(style.ImHexViewerSize, content_width + imgui_style.FramePadding.x * 2.0f + scrollbar_width, ImMax(ImGui::GetContentRegionAvail().y, line_height * 8.0f));
+
+    ImGui::InvisibleButton("##hex", ImVec2(ImMax(size.x - scrollbar_width, 1.0f), size.y));
+    const ImRect frame(ImGui::GetItemRectMin(), ImVec2(ImGui::GetItemRectMin().x + size.x, ImGui::GetItemRectMax().y));
+    const bool hovered = ImGui::IsItemHovered();
+    const bool active = ImGui::IsItemActive();
+    const bool focused = ImGui::IsItemFocused();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(frame.Min, frame.Max, ImGui::GetColorU32(ImGuiCol_FrameBg), imgui_style.FrameRounding);
+
+    const ImVec2 origin(frame.Min.x + imgui_style.FramePadding.x, frame.Min.y + imgui_style.FramePadding.y);
+    const float hex_x = origin.x + (address_digits + 2) * char_width;
+    const float ascii_x = hex_x + (row_bytes * 3 + 1 + 1) * char_width;
+    const ImS64 row_count = (ImS64)st.RowCount();
+    const ImS64 full_rows = ImMax((ImS64)((frame.GetHeight() - imgui_style.FramePadding.y * 2.0f) / line_height), (ImS64)1);
+
+    auto byte_x = [&](int column) { return hex_x + (column * 3 + (column >= row_bytes / 2 ? 1 : 0)) * char_width; };
+    // Byte under 'pos', or the nearest one when clamping (for drags), -1 if none
+    auto hit_test = [&](const ImVec2& pos, bool clamp) -> ImS64 {
+        if (st.Size == 0)
+            return -1;
+        ImS64 row = st.ScrollRow + (ImS64)floorf((pos.y - origin.y) / line_height);
+        int column;
+        if (show_ascii && pos.x >= ascii_x - char_width * 0.5f)
+            column = (int)floorf((pos.x - ascii_x) / char_width);
+        else {
+            float x = pos.x - hex_x;
+            if (x >= (row_bytes / 2) * 3 * char_width)
+                x -= char_width;
+            column = (int)floorf(x / (3 * char_width));
+        }
+        if (!clamp && (row < st.ScrollRow || row >= st.ScrollRow + full_rows + 1 || column < 0 || column >= row_bytes || pos.x < hex_x))
+            return -1;
+        ImS64 offset = ImClamp(row, (ImS64)0, row_count - 1) * row_bytes + ImClamp(column, 0, row_bytes - 1);
+        if ((ImU64)offset >= st.Size)
+            return clamp ? (ImS64)st.Size - 1 : -1;
+        return offset;
+    };
+
+    // Click selects, drag or shift-click extends, wheel and keys scroll
+    ImGuiIO& io = ImGui::GetIO();
+    const ImS64 hovered_offset = hovered ? hit_test(io.MousePos, false) : -1;
+    if (hovered) {
+        ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
+        if (io.MouseWheel != 0.0f) {
+            ImS64 rows = (ImS64)(io.MouseWheel * 3.0f);
+            st.ScrollRow -= rows != 0 ? rows : (io.MouseWheel > 0.0f ? 1 : -1);
+        }
+    }
+    if (ImGui::IsItemActivated() && st.Size) {
+        ImS64 offset = hit_test(io.MousePos, true);
+        if (!(io.KeyShift && st.HasSelection))
+            st.SelAnchor = (ImU64)offset;
+        st.SelCursor = (ImU64)offset;
+        st.HasSelection = true;
+    } else if (active && st.Size && io.MouseDown[ImGuiMouseButton_Left]) {
+        if (io.MousePos.y < origin.y)
+            st.ScrollRow--;
+        else if (io.MousePos.y > frame.Max.y - imgui_style.FramePadding.y)
+            st.ScrollRow++;
+        st.SelCursor = (ImU64)hit_test(io.MousePos, true);
+    }
+    if (focused && st.HasSelection) {
+        // Keep navigation from moving focus away
+        for (ImGuiKey key : { ImGuiKey_LeftArrow, ImGuiKey_RightArrow, ImGuiKey_UpArrow, ImGuiKey_DownArrow, ImGuiKey_PageUp, ImGuiKey_PageDown })
+            ImGui::SetKeyOwner(key, ImGui::GetItemID());
+        ImS64 cursor = (ImS64)st.SelCursor;
+        if (ImGui::IsKeyPressed(ImGuiKey_LeftArrow))  cursor -= 1;
+        if (ImGui::IsKeyPressed(ImGuiKey_RightArrow)) cursor += 1;
+        if (ImGui::IsKeyPressed(ImGuiKey_UpArrow))    cursor -= row_bytes;
+        if (ImGui::IsKeyPressed(ImGuiKey_DownArrow))  cursor += row_bytes;
+        if (ImGui::IsKeyPressed(ImGuiKey_PageUp))     cursor -= full_rows * row_bytes;
+        if (ImGui::IsKeyPressed(ImGuiKey_PageDown))   cursor += full_rows * row_bytes;
+        cursor = ImClamp(cursor, (ImS64)0, (ImS64)st.Size - 1);
+        if ((ImU64)cursor != st.SelCursor) {
+            st.SelCursor = (ImU64)cursor;
+            if (!io.KeyShift)
+                st.SelAnchor = st.SelCursor;
+            ImS64 row = cursor / row_bytes;
+            st.ScrollRow = ImClamp(st.ScrollRow, row - full_rows + 1, row);
+        }
+        if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_C)) {
+            const ImU64 max_copy = 1 << 20;
+            const ImU64 begin = st.SelectionMin(), count = ImMin(st.SelectionMax() - begin + 1, max_copy);
+            std::string text((size_t)(count + 15) / 16 * 48, ' ');
+            std::vector<unsigned char> bytes((size_t)(count + 15) / 16 * 16, 0);
+            st.Read(begin, bytes.data(), (size_t)count);
+            char ascii[16];
+            for (ImU64 i = 0; i < count; i += 16)
+                HexEncodeRow(bytes.data() + i, &text[(size_t)i * 3], ascii);
+            text.resize((size_t)count * 3 - 1);
+            ImGui::SetClipboardText(text.c_str());
+        }
+    }
+    if (st.ScrollToCursor) {
+        st.ScrollRow = (ImS64)(st.SelCursor / row_bytes) - full_rows / 2;
+        st.ScrollToCursor = false;
+    }
+
+    const ImRect scrollbar(ImVec2(frame.Max.x - scrollbar_width, frame.Min.y), frame.Max);
+    st.ScrollRow = ImClamp(st.ScrollRow, (ImS64)0, ImMax(row_count - full_rows, (ImS64)0));
+    if (row_count > full_rows)
+        ImGui::ScrollbarEx(scrollbar, ImGui::GetID("##scroll"), ImGuiAxis_Y, &st.ScrollRow, full_rows, row_count, ImDrawFlags_RoundCornersRight);
+
+    // Read the visible rows at once, zero-padded to whole rows, and convert them
+    const ImS64 first_row = st.ScrollRow;
+    const int rows = (int)ImMin(full_rows + 1, row_count - first_row);
+    const int row_chars = ImHexViewerState::RowChars;
+    unsigned char* bytes = FrameAllocArray<unsigned char>(ImMax(rows, 1) * row_bytes);
+    const ImU64 read_begin = (ImU64)first_row * row_bytes;
+    const size_t read_size = (size_t)ImMin((ImU64)rows * row_bytes, st.Size - read_begin);
+    memset(bytes + read_size, 0, (size_t)rows * row_bytes - read_size);
+    st.Read(read_begin, bytes, read_size);
+    char* text = FrameAllocArray<char>(ImMax(rows, 1) * row_chars);
+    for (int r = 0; r < rows; r++) {
+        const ImU64 begin = read_begin + (ImU64)r * row_bytes;
+        char* line = text + r * row_chars;
+        for (int d = 0; d < address_digits; d++)
+            line[d] = "0123456789ABCDEF"[(begin >> ((address_digits - 1 - d) * 4)) & 15];
+        HexEncodeRow(bytes + r * row_bytes, line + 16, line + 16 + row_bytes * 3);
+    }
+
+    draw_list->PushClipRect(frame.Min, ImVec2(scrollbar.Min.x, frame.Max.y), true);
+
+    // Highlights of [begin, end) on every visible row it covers
+    const ImU64 visible_begin = (ImU64)first_row * row_bytes;
+    const ImU64 visible_end = ImMin(visible_begin + (ImU64)rows * row_bytes, st.Size);
+    auto highlight = [&](ImU64 begin, ImU64 end, ImU32 col) {
+        begin = ImMax(begin, visible_begin);
+        end = ImMin(end, visible_end);
+        for (ImU64 p = begin; p < end; ) {
+            const ImU64 row_end = ImMin((p / row_bytes + 1) * row_bytes, end);
+            const int c0 = (int)(p % row_bytes), c1 = (int)((row_end - 1) % row_bytes);
+            const float y = origin.y + (float)(p / row_bytes - (ImU64)first_row) * line_height;
+            draw_list->AddRectFilled(ImVec2(byte_x(c0) - char_width * 0.5f, y), ImVec2(byte_x(c1) + char_width * 2.5f, y + line_height), col);
+            if (show_ascii)
+                draw_list->AddRectFilled(ImVec2(ascii_x + c0 * char_width, y), ImVec2(ascii_x + (c1 + 1) * char_width, y + line_height), col);
+            p = row_end;
+        }
+    };
+    if (ImTextSearch* search = st.Search.get()) {
+        const ImU64 length = st.Pattern.size();
+        const ImU32 col_match = ImWidgets::GetColorU32(ImWidgetsCol_HexViewerMatch);
+        search->ForEachMatch(visible_begin > length ? visible_begin - length + 1 : 0, visible_end, [&](ImU64 offset) {
+            highlight(offset, offset + length, col_match);
+        });
+    }
+    if (st.HasSelection)
+        highlight(st.SelectionMin(), st.SelectionMax() + 1, ImWidgets::GetColorU32(ImWidgetsCol_HexViewerSelection));
+    if (hovered_offset >= 0 && !active)
+        highlight((ImU64)hovered_offset, (ImU64)hovered_offset + 1, ImGui::GetColorU32(ImGuiCol_FrameBgHovered));
+
+    const ImU32 col_address = ImWidgets::GetColorU32(ImWidgetsCol_HexViewerAddress);
+    const ImU32 col_text = ImGui::GetColorU32(ImGuiCol_Text);
+    const ImU32 col_ascii = ImWidgets::GetColorU32(ImWidgetsCol_HexViewerAscii);
+    for (int r = 0; r < rows; r++) {
+        const char* line = text + r * row_chars;
+        const ImU64 begin = (ImU64)(first_row + r) * row_bytes;
+        const int count = (int)ImMin(st.Size - begin, (ImU64)row_bytes);
+        const float y = origin.y + r * line_height;
+        const char* hex = line + 16;
+        draw_list->AddText(ImVec2(origin.x, y), col_address, line, line + address_digits);
+        draw_list->AddText(ImVec2(byte_x(0), y), col_text, hex, hex + ImMin(count, row_bytes / 2) * 3 - 1);
+        if (count > row_bytes / 2)
+            draw_list->AddText(ImVec2(byte_x(row_bytes / 2), y), col_text, hex + (row_bytes / 2) * 3, hex + count * 3 - 1);
+        if (show_ascii)
+            draw_list->AddText(ImVec2(ascii_x, y), col_ascii, hex + row_bytes * 3, hex + row_bytes * 3 + count);
+    }
+    draw_list->PopClipRect();
+
+    // Data inspector: every integer and float type starting at the hovered byte, in both byte orders
+    if (hovered_offset >= 0 && !active && !(flags & ImHexViewerFlags_NoInspector)) {
+        unsigned char bytes[8];
+        const int available = (int)ImMin(st.Size - (ImU64)hovered_offset, (ImU64)8);
+        st.Read((ImU64)hovered_offset, bytes, (size_t)available);
+        static const struct { const char* Name; int Size; ImGuiDataType Type; } types[] = {
+            { "u8",  1, ImGuiDataType_U8 },  { "i8",  1, ImGuiDataType_S8 },
+            { "u16", 2, ImGuiDataType_U16 }, { "i16", 2, ImGuiDataType_S16 },
+            { "u32", 4, ImGuiDataType_U32 }, { "i32", 4, ImGuiDataType_S32 },
+            { "u64", 8, ImGuiDataType_U64 }, { "i64", 8, ImGuiDataType_S64 },
+            { "f32", 4, ImGuiDataType_Float }, { "f64", 8, ImGuiDataType_Double },
+        };
+        ImGui::BeginTooltip();
+        ImGui::Text("Offset 0x%llX (%llu)", (unsigned long long)hovered_offset, (unsigned long long)hovered_offset);
+        if (ImGui::BeginTable("##inspector", 3, ImGuiTableFlags_SizingFixedFit)) {
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Little endian");
+            ImGui::TableSetupColumn("Big endian");
+            ImGui::TableHeadersRow();
+            char buf[64];
+            for (const auto& t : types) {
+                if (t.Size > available)
+                    break;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(t.Name);
+                for (int big_endian = 0; big_endian < 2; big_endian++) {
+                    unsigned char value[8];
+                    for (int i = 0; i < t.Size; i++)
+                        value[i] = bytes[big_endian ? t.Size - 1 - i : i];
+                    // Assumes a little endian host
+                    const bool is_float = t.Type == ImGuiDataType_Float || t.Type == ImGuiDataType_Double;
+                    ImGui::DataTypeFormatString(buf, IM_ARRAYSIZE(buf), t.Type, value, is_float ? "%g" : ImGui::DataTypeGetInfo(t.Type)->PrintFmt);
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(buf);
+                }
+            }
+            ImGui::EndTable();
+        }
+        ImGui::EndTooltip();
+    }
+}
+
+void ImWidgets::HexViewer(const char* label, const char* path, ImHexViewerFlags flags) {
+    ImHexViewerState& st = GetHexViewerState(ImGui::GetID(label));
+    if (st.Path != path)
+        st.Open(path);
+    ImGui::PushID(label);
+    HexViewerEx(st, flags);
+    ImGui::PopID();
+}
+
+void ImWidgets::HexViewer(const char* label, const void* data, ImU64 size, ImHexViewerFlags flags) {
+    ImHexViewerState& st = GetHexViewerState(ImGui::GetID(label));
+    if (!st.Path.empty() || st.Data != (const char*)data || st.Size != size)
+        st.SetData((const char*)data, size);
+    ImGui::PushID(label);
+    HexViewerEx(st, flags);
+    ImGui::PopID();
+}
+
+bool ImWidgets::HexViewerGetSelection(const char* label, ImU64* offset, ImU64* size) {
+    ImHexViewerState& st = GetHexViewerState(ImGui::GetID(label));
+    if (!st.HasSelection)
+        return false;
+    if (offset)
+        *offset = st.SelectionMin();
+    if (size)
+        *size = st.SelectionMax() - st.SelectionMin() + 1;
+    return true;
+}
+
+void ImWidgets::HexViewerSetSelection(const char* label, ImU64 offset, ImU64 size) {
+    ImHexViewerState& st = GetHexViewerState(ImGui::GetID(label));
+    st.HasSelection = size > 0;
+    st.SelAnchor = offset;
+    st.SelCursor = offset + (size > 0 ? size - 1 : 0);
+    st.SearchCursor = offset;
+    st.ScrollToCursor = st.HasSelection;
+}
+
+/*
+    FUZZY SEARCH
+*/
+
+struct ImFuzzyQuery {
+    static const int    MaxLength = 64;
+    char                Text[MaxLength];    // Lowercased unless CaseSensitive
+    int                 Length = 0;
+    ImU32               Mask = 0;
+    bool                CaseSensitive = false;
+};
+
+struct ImFuzzyResult {
+    int     Score;
+    int     Index;
+};
+
+static inline char FuzzyLower(char c) { return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c; }
+
+// One bit per letter, case folded, and 6 shared by digits. An item can only match if it has all the query's bits.
+static inline ImU32 FuzzyCharBit(char c) {
+    c = FuzzyLower(c);
+    if (c >= 'a' && c <= 'z')
+        return 1u << (c - 'a');
+    if (c >= '0' && c <= '9')
+        return 1u << (26 + (c - '0') % 6);
+    return 0;
+}
+
+static ImU32 FuzzyCharMask(const char* s) {
+    ImU32 mask = 0;
+    for (; *s; s++)
+        mask |= FuzzyCharBit(*s);
+    return mask;
+}
+
+static ImFuzzyQuery MakeFuzzyQuery(const char* text, bool case_sensitive) {
+    ImFuzzyQuery q;
+    q.CaseSensitive = case_sensitive;
+    for (; *text && q.Length < ImFuzzyQuery::MaxLength; text++) {
+        q.Text[q.Length++] = case_sensitive ? *text : FuzzyLower(*text);
+        q.Mask |= FuzzyCharBit(*text);
+    }
+    return q;
+}
+
+static inline bool FuzzyIsWordStart(const char* text, int i) {
+    if (i == 0)
+        return true;
+    const char prev = text[i - 1], c = text[i];
+    return prev == ' ' || prev == '_' || prev == '-' || prev == '/' || prev == '.' || prev == ':' || (prev >= 'a' && prev <= 'z' && c >= 'A' && c <= 'Z');
+}
+
+// Matches the query's characters in order, greedily. Returns 0 if they don't all appear, otherwise a score
+// rewarding consecutive characters and word starts and penalizing gaps. Fills positions (Length entries) if given.
+static int FuzzyScore(const ImFuzzyQuery& q, const char* text, int* positions) {
+    int score = 0, last = -1;
+    const char* t = text;
+    for (int qi = 0; qi < q.Length; qi++, t++) {
+        for (;; t++) {
+            if (!*t)
+                return 0;
+            if ((q.CaseSensitive ? *t : FuzzyLower(*t)) == q.Text[qi])
+                break;
+        }
+        const int i = (int)(t - text);
+        score += 16;
+        if (qi > 0 && i == last + 1)
+            score += 12;
+        else
+            score -= ImMin(i - last - 1, 8);
+        if (FuzzyIsWordStart(text, i))
+            score += 10;
+        if (positions)
+            positions[qi] = i;
+        last = i;
+    }
+    return ImMax(score, 1);
+}
+
+static bool FuzzyResultBetter(const ImFuzzyResult& a, const ImFuzzyResult& b) {
+    return a.Score != b.Score ? a.Score > b.Score : a.Index < b.Index;
+}
+
+// Keeps the best max_results, best first
+static void FuzzyKeepBest(std::vector<ImFuzzyResult>& results, int max_results) {
+    if ((int)results.size() > max_results) {
+        std::nth_element(results.begin(), results.begin() + max_results, results.end(), FuzzyResultBetter);
+        results.resize(max_results);
+    }
+    std::sort(results.begin(), results.end(), FuzzyResultBetter);
+}
+
+// Scores candidates[begin, end), or items [begin, end) when candidates is null, appending matching item indices
+// (in order) to 'matches'. Items whose mask misses some of the query's bits are skipped unscored, 8 or 4 at a time.
+static void FuzzyMatchRange(const ImFuzzyQuery& q, const char* const* items, const ImU32* masks, const int* candidates, int begin, int end,
+                            std::vector<int>& matches, std::vector<ImFuzzyResult>& results, const std::atomic<bool>& cancel) {
+    auto score = [&](int index) {
+        int s = FuzzyScore(q, items[index], nullptr);
+        if (s > 0) {
+            matches.push_back(index);
+            results.push_back({ s, index });
+        }
+    };
+    const int cancel_check = 4096;
+    if (candidates) {
+        for (int i = begin; i < end; i++) {
+            if ((i & (cancel_check - 1)) == 0 && cancel)
+                return;
+            if ((masks[candidates[i]] & q.Mask) == q.Mask)
+                score(candidates[i]);
+        }
+        return;
+    }
+    int i = begin;
+#if defined(__AVX2__)
+    const __m256i query8 = _mm256_set1_epi32((int)q.Mask);
+    for (; i + 8 <= end; i += 8) {
+        if ((i & (cancel_check - 1)) == 0 && cancel)
+            return;
+        __m256i m = _mm256_loadu_si256((const __m256i*)(masks + i));
+        ImU32 hits = (ImU32)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(m, query8), query8)));
+        for (; hits; hits &= hits - 1)
+            score(i + CountTrailingZeros(hits));
+    }
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i query4 = _mm_set1_epi32((int)q.Mask);
+    for (; i + 4 <= end; i += 4) {
+        if ((i & (cancel_check - 1)) == 0 && cancel)
+            return;
+        __m128i m = _mm_loadu_si128((const __m128i*)(masks + i));
+        ImU32 hits = (ImU32)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(m, query4), query4)));
+        for (; hits; hits &= hits - 1)
+            score(i + CountTrailingZeros(hits));
+    }
+#endif
+    for (; i < end; i++)
+        if ((masks[i] & q.Mask) == q.Mask)
+            score(i);
+}
+
+// Splits the candidates in 'parts' run on the pool, each keeping its best results, then merges them
+static void FuzzySearchRun(const ImFuzzyQuery& q, const char* const* items, const ImU32* masks, const int* candidates, int count, int max_results, int parts,
+                           std::vector<int>& matches, std::vector<ImFuzzyResult>& best, const std::atomic<bool>& cancel) {
+    parts = ImMax(ImMin(parts, count / 4096), 1);
+    std::vector<std::vector<int>> part_matches(parts);
+    std::vector<std::vector<ImFuzzyResult>> part_results(parts);
+    auto run_part = [&](int i) {
+        FuzzyMatchRange(q, items, masks, candidates, (int)((ImS64)count * i / parts), (int)((ImS64)count * (i + 1) / parts), part_matches[i], part_results[i], cancel);
+        FuzzyKeepBest(part_results[i], max_results);
+    };
+    ParallelFor(parts, run_part);
+
+    matches.clear();
+    best.clear();
+    for (int i = 0; i < parts; i++) {
+        matches.insert(matches.end(), part_matches[i].begin(), part_matches[i].end());
+        best.insert(best.end(), part_results[i].begin(), part_results[i].end());
+    }
+    FuzzyKeepBest(best, max_results);
+}
+
+static void BuildFuzzyMasks(const char* const* items, int count, std::vector<ImU32>& masks, const std::atomic<bool>& cancel) {
+    masks.resize(count);
+    for (int i = 0; i < count && !cancel; i++)
+        masks[i] = FuzzyCharMask(items[i]);
+}
+
+struct ImFuzzySearchJob : ImWidgetsJob {
+    std::string         Query;
+    bool                CaseSensitive = false;
+    std::vector<int>    Candidates;
+    std::vector<ImU32>  Masks;              // Built by the job when the state had none yet
+    std::vector<int>    Matches;
+    std::vector<ImFuzzyResult> Best;
+};
+
+struct ImFuzzySearchState {
+    // Up to this many candidates are scored on the UI thread, in the frame the query changed
+    static const int    SyncCandidates = 1 << 14;
+
+    const char* const*  Items = nullptr;
+    int                 Count = -1;
+    int                 Version = 0;
+    std::vector<ImU32>  Masks;
+
+    // Published results of Query: every match (item order) for narrowing, and the best ones for display
+    bool                HasResults = false;
+    std::string         Query;
+    bool                CaseSensitive = false;
+    bool                MatchesAll = false;
+    std::vector<int>    Matches;
+    std::vector<ImFuzzyResult> Best;
+    ImWidgetsJobPtr<ImFuzzySearchJob> Job;
+
+    char                Input[256] = "";
+    int                 Highlighted = 0;
+    bool                ScrollToHighlighted = false;
+
+    void Publish(const std::string& query, bool case_sensitive, std::vector<int>& matches, std::vector<ImFuzzyResult>& best) {
+        HasResults = true;
+        Query = query;
+        CaseSensitive = case_sensitive;
+        MatchesAll = false;
+        Matches.swap(matches);
+        Best.swap(best);
+        Highlighted = 0;
+        ScrollToHighlighted = true;
+    }
+
+    int MatchCount() const { return MatchesAll ? Count : (int)Matches.size(); }
+
+    void Update(ImGuiID owner, const char* const* items, int count, int version, int max_results, bool case_sensitive) {
+        if (items != Items || count != Count || version != Version) {
+            Job.reset();
+            Items = items;
+            Count = count;
+            Version = version;
+            Masks.clear();
+            HasResults = false;
+        }
+        if (Job && Job->Done) {
+            if (!Job->Masks.empty())
+                Masks.swap(Job->Masks);
+            Publish(Job->Query, Job->CaseSensitive, Job->Matches, Job->Best);
+            Job.reset();
+        }
+        else if (Job && Job->Abandoned()) {
+            Job.reset();    // Cancelled while the popup was closed, searched again below
+        }
+
+        const ImFuzzyQuery q = MakeFuzzyQuery(Input, case_sensitive);
+        const std::string query(q.Text, q.Length);
+        if (HasResults && Query == query && CaseSensitive == case_sensitive)
+            return;
+        if (Job && Job->Query == query && Job->CaseSensitive == case_sensitive)
+            return;
+        Job.reset();
+
+        if (q.Length == 0) {
+            std::vector<int> none;
+            std::vector<ImFuzzyResult> first(ImMin(count, max_results));
+            for (int i = 0; i < (int)first.size(); i++)
+                first[i] = { 0, i };
+            Publish(query, case_sensitive, none, first);
+            MatchesAll = true;
+            return;
+        }
+
+        // Letters only get added: the new matches are among the previous ones
+        const bool narrow = HasResults && !MatchesAll && CaseSensitive == case_sensitive && query.compare(0, Query.size(), Query) == 0;
+        const int candidates_count = narrow ? (int)Matches.size() : count;
+        if (candidates_count <= SyncCandidates && (!Masks.empty() || count <= SyncCandidates)) {
+            static const std::atomic<bool> never_cancel{ false };
+            if (Masks.empty())
+                BuildFuzzyMasks(items, count, Masks, never_cancel);
+            std::vector<int> matches;
+            std::vector<ImFuzzyResult> best;
+            FuzzySearchRun(q, items, Masks.data(), narrow ? Matches.data() : nullptr, candidates_count, max_results, 1, matches, best, never_cancel);
+            Publish(query, case_sensitive, matches, best);
+            return;
+        }
+
+        Job.reset(new ImFuzzySearchJob());
+        ImFuzzySearchJob* job = Job.get();
+        job->Query = query;
+        job->CaseSensitive = case_sensitive;
+        if (narrow)
+            job->Candidates = Matches;
+        const ImU32* masks = Masks.empty() ? nullptr : Masks.data();
+        job->Start(owner, [job, q, items, count, masks, narrow, candidates_count, max_results]() {
+            const ImU32* m = masks;
+            if (!m) {
+                BuildFuzzyMasks(items, count, job->Masks, job->Cancel);
+                m = job->Masks.data();
+            }
+            const int parts = TaskPoolThreads();
+            FuzzySearchRun(q, items, m, narrow ? job->Candidates.data() : nullptr, candidates_count, max_results, parts, job->Matches, job->Best, job->Cancel);
+        });
+    }
+};
+
+// Draws 'text' with the characters at positions[0, count) (ascending) in another color
+static void DrawFuzzyMatchText(ImDrawList* draw_list, ImVec2 pos, const char* text, const int* positions, int count, ImU32 col_text, ImU32 col_match) {
+    const char* text_end = text + strlen(text);
+    const char* p = text;
+    for (int i = 0; i < count; ) {
+        const char* match_begin = text + positions[i];
+        int j = i + 1;
+        while (j < count && positions[j] == positions[j - 1] + 1)
+            j++;
+        const char* match_end = text + positions[j - 1] + 1;
+        if (p < match_begin) {
+            draw_list->AddText(pos, col_text, p, match_begin);
+            pos.x += ImGui::CalcTextSize(p, match_begin).x;
+        }
+        draw_list->AddText(pos, col_match, match_begin, match_end);
+        pos.x += ImGui::CalcTextSize(match_begin, match_end).x;
+        p = match_end;
+        i = j;
+    }
+    if (p < text_end)
+        draw_list->AddText(pos, col_text, p, text_end);
+}
+
+// Query input and result list shared by FuzzyCombo() and CommandPalette(), returns the picked item or -1
+static int FuzzySearchPopupBody(ImFuzzySearchState& st, const char* const* items, int items_count, int items_version, ImFuzzySearchFlags flags, const char* hint) {
+    const ImWidgetsStyle& style = GetContext().Style;
+    const bool case_sensitive = (flags & ImFuzzySearchFlags_CaseSensitive) != 0;
+    const int max_results = ImMax(style.ImFuzzySearchMaxResults, 1);
+
+    if (ImGui::IsWindowAppearing()) {
+        st.Input[0] = 0;
+        ImGui::SetKeyboardFocusHere();
+    }
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    ImGui::InputTextWithHint("##query", hint, st.Input, IM_ARRAYSIZE(st.Input));
+    if (ImGui::IsItemActive()) {
+        // Keep navigation from leaving the input
+        for (ImGuiKey key : { ImGuiKey_UpArrow, ImGuiKey_DownArrow, ImGuiKey_PageUp, ImGuiKey_PageDown })
+            ImGui::SetKeyOwner(key, ImGui::GetItemID());
+    }
+    const ImGuiID owner = ImGui::GetID("##query");
+    KeepTaskOwnerAlive(owner);
+    st.Update(owner, items, items_count, items_version, max_results, case_sensitive);
+
+    const int rows = (int)st.Best.size();
+    const float row_height = ImGui::GetTextLineHeightWithSpacing();
+    const float list_height = style.ImFuzzySearchListHeight > 0.0f ? style.ImFuzzySearchListHeight : row_height * 12.0f;
+    const int page = ImMax((int)(list_height / row_height) - 1, 1);
+    int picked = -1;
+    if (rows > 0) {
+        int highlighted = st.Highlighted;
+        if (ImGui::IsKeyPressed(ImGuiKey_UpArrow))    highlighted--;
+        if (ImGui::IsKeyPressed(ImGuiKey_DownArrow))  highlighted++;
+        if (ImGui::IsKeyPressed(ImGuiKey_PageUp))     highlighted -= page;
+        if (ImGui::IsKeyPressed(ImGuiKey_PageDown))   highlighted += page;
+        highlighted = ImClamp(highlighted, 0, rows - 1);
+        if (highlighted != st.Highlighted) {
+            st.Highlighted = highlighted;
+            st.ScrollToHighlighted = true;
+        }
+        if (ImGui::IsKeyPressed(ImGuiKey_Enter) || ImGui::IsKeyPressed(ImGuiKey_KeypadEnter))
+            picked = st.Best[st.Highlighted].Index;
+    }
+
+    if (st.MatchesAll)
+        ImGui::TextDisabled("%d items", items_count);
+    else
+        ImGui::TextDisabled("%d of %d%s", st.MatchCount(), items_count, st.Job ? " ..." : "");
+
+    ImGui::BeginChild("##results", ImVec2(0.0f, list_height));
+    if (st.ScrollToHighlighted) {
+        const float y = st.Highlighted * row_height;
+        if (y < ImGui::GetScrollY())
+            ImGui::SetScrollY(y);
+        else if (y + row_height > ImGui::GetScrollY() + ImGui::GetWindowHeight())
+            ImGui::SetScrollY(y + row_height - ImGui::GetWindowHeight());
+        st.ScrollToHighlighted = false;
+    }
+    const ImFuzzyQuery q = MakeFuzzyQuery(st.Input, case_sensitive);
+    const ImU32 col_text = ImGui::GetColorU32(ImGuiCol_Text);
+    const ImU32 col_match = ImWidgets::GetColorU32(ImWidgetsCol_FuzzySearchMatch);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    int positions[ImFuzzyQuery::MaxLength];
+    ImGuiListClipper clipper;
+    clipper.Begin(rows, row_height);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            const int index = st.Best[row].Index;
+            ImGui::PushID(row);
+            if (ImGui::Selectable("##item", row == st.Highlighted))
+                picked = index;
+            ImGui::PopID();
+            // Results may still be those of a shorter query, so positions are found again for this one
+            const int matched = (flags & ImFuzzySearchFlags_NoHighlight) == 0 && q.Length > 0 && FuzzyScore(q, items[index], positions) > 0 ? q.Length : 0;
+            DrawFuzzyMatchText(draw_list, ImGui::GetItemRectMin(), items[index], positions, matched, col_text, col_match);
+        }
+    }
+    clipper.End();
+    ImGui::EndChild();
+    return picked;
+}
+
+bool ImWidgets::FuzzyCombo(const char* label, int* current, const char* const items[], int items_count, int items_version, ImFuzzySearchFlags flags) {
+    std::unordered_map<ImGuiID, ImFuzzySearchState>& fuzzyComboStates = GetStatePool<ImFuzzySearchState>(ImWidgetsContextSlot_FuzzyCombo);
+    ImFuzzySearchState& st = fuzzyComboStates[ImGui::GetID(label)];
+
+    const char* preview = (*current >= 0 && *current < items_count) ? items[*current] : "";
+    if (!ImGui::BeginCombo(label, preview))
+        return false;
+    bool changed = false;
+    int picked = FuzzySearchPopupBody(st, items, items_count, items_version, flags, "Search");
+    if (picked >= 0) {
+        *current = picked;
+        changed = true;
+        ImGui::CloseCurrentPopup();
+    } else if (ImGui::IsKeyPressed(ImGuiKey_Escape)) {
+        ImGui::CloseCurrentPopup();
+    }
+    ImGui::EndCombo();
+    return changed;
+}
+
+bool ImWidgets::CommandPalette(const char* label, bool* p_open, int* selected, const char* const items[], int items_count, int items_version, ImFuzzySearchFlags flags) {
+    std::unordered_map<ImGuiID, ImFuzzySearchState>& commandPaletteStates = GetStatePool<ImFuzzySearchState>(ImWidgetsContextSlot_CommandPalette);
+    ImFuzzySearchState& st = commandPaletteStates[ImGui::GetID(label)];
+    const ImWidgetsStyle& style = GetContext().Style;
+
+    if (*p_open && !ImGui::IsPopupOpen(label))
+        ImGui::OpenPopup(label);
+
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    const float width = style.ImCommandPaletteWidth > 0.0f ? style.ImCommandPaletteWidth : viewport->WorkSize.x * 0.4f;
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x * 0.5f, viewport->WorkPos.y + viewport->WorkSize.y * 0.15f), ImGuiCond_Always, ImVec2(0.5f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(width, 0.0f));
+    bool chosen = false;
+    if (ImGui::BeginPopup(label)) {
+        int picked = FuzzySearchPopupBody(st, items, items_count, items_version, flags, "Type a command");
+        if (picked >= 0) {
+            *selected = picked;
+            chosen = true;
+            ImGui::CloseCurrentPopup();
+        } else if (ImGui::IsKeyPressed(ImGuiKey_Escape)) {
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
+    *p_open = ImGui::IsPopupOpen(label);
+    return chosen;
+}
+
+/*
+    TOGGLE GRID
+*/
+
+struct ImToggleGridState {
+    std::unordered_map<int, float> Anims;   // Knob position of cells still moving, keyed by bit index
+    int     PaintValue = -1;                // Value being painted while dragging, -1 when not
+    int     LastCell = -1;
+};
+
+bool ImWidgets::ToggleGrid(const char* label, ImU32* bits, int columns, int rows, const char* const row_labels[], const char* const column_labels[], ImToggleGridFlags flags) {
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems || columns <= 0 || rows <= 0)
+        return false;
+
+    std::unordered_map<ImGuiID, ImToggleGridState>& toggleGridStates = GetStatePool<ImToggleGridState>(ImWidgetsContextSlot_ToggleGrid);
+    const ImWidgetsStyle& style = GetContext().Style;
+    const ImGuiID id = ImGui::GetID(label);
+    ImToggleGridState& st = toggleGridStates[id];
+    const bool disabled = (flags & ImToggleGridFlags_Disabled) != 0;
+
+    const ImVec2 cell = style.ImToggleGridCellSize;
+    const ImVec2 step(cell.x + style.ImToggleGridSpacing, cell.y + style.ImToggleGridSpacing);
+    const ImVec2 origin = window->DC.CursorPos;
+    const ImVec2 size(columns * step.x - style.ImToggleGridSpacing, rows * step.y - style.ImToggleGridSpacing);
+    const ImRect frame(origin, ImVec2(origin.x + size.x, origin.y + size.y));
+    ImGui::ItemSize(size);
+    if (!ImGui::ItemAdd(frame, id))
+        return false;
+
+    // One hit-test for the whole grid
+    bool hovered, held;
+    ImGui::ButtonBehavior(frame, id, &hovered, &held);
+    ImGuiIO& io = ImGui::GetIO();
+    auto cell_at = [&](const ImVec2& pos) {
+        const int c = (int)floorf((pos.x - origin.x) / step.x), r = (int)floorf((pos.y - origin.y) / step.y);
+        if (c < 0 || c >= columns || r < 0 || r >= rows)
+            return -1;
+        // Spacing between cells isn't part of them
+        if (pos.x - origin.x - c * step.x >= cell.x || pos.y - origin.y - r * step.y >= cell.y)
+            return -1;
+        return r * columns + c;
+    };
+    auto get_bit = [bits](int i) { return (bits[i >> 5] >> (i & 31)) & 1; };
+    const int hovered_cell = hovered ? cell_at(io.MousePos) : -1;
+
+    // Click toggles, dragging paints the clicked cell's new value
+    bool changed = false;
+    if (!disabled) {
+        if (ImGui::IsItemActivated() && hovered_cell >= 0)
+            st.PaintValue = !get_bit(hovered_cell);
+        if (held && st.PaintValue >= 0) {
+            const int i = cell_at(io.MousePos);
+            if (i >= 0 && i != st.LastCell && (int)get_bit(i) != st.PaintValue) {
+                if (!(flags & ImToggleGridFlags_NoAnimation))
+                    st.Anims.emplace(i, (float)!st.PaintValue);
+                bits[i >> 5] ^= 1u << (i & 31);
+                changed = true;
+            }
+            st.LastCell = i;
+        }
+        if (!held) {
+            st.PaintValue = -1;
+            st.LastCell = -1;
+        }
+    }
+
+    // Advance the moving knobs, cells that arrived stop animating
+    const float rate = ImClamp(20.0f * io.DeltaTime, 0.0f, 1.0f);
+    for (auto it = st.Anims.begin(); it != st.Anims.end(); ) {
+        const float target = (float)get_bit(it->first);
+        it->second += (target - it->second) * rate;
+        if (fabsf(target - it->second) < 0.01f)
+            it = st.Anims.erase(it);
+        else
+            ++it;
+    }
+
+    // Visible cells only, each one a background and a knob quad
+    const int c0 = ImMax((int)floorf((window->ClipRect.Min.x - origin.x) / step.x), 0);
+    const int c1 = ImMin((int)ceilf((window->ClipRect.Max.x - origin.x) / step.x), columns);
+    const int r0 = ImMax((int)floorf((window->ClipRect.Min.y - origin.y) / step.y), 0);
+    const int r1 = ImMin((int)ceilf((window->ClipRect.Max.y - origin.y) / step.y), rows);
+    const ImU32 col_off = GetColorU32(disabled ? ImWidgetsCol_ToggleSwitchDisabled : ImWidgetsCol_ToggleSwitchOff);
+    const ImU32 col_on = GetColorU32(disabled ? ImWidgetsCol_ToggleSwitchDisabled : ImWidgetsCol_ToggleSwitchOn);
+    const ImU32 col_knob = GetColorU32(ImWidgetsCol_ToggleSwitchKnob);
+    const float pad = ImMax(cell.y * 0.15f, 1.0f);
+    const float knob = cell.y - pad * 2.0f;
+    const float knob_travel = cell.x - pad * 2.0f - knob;
+    {
+        ImQuadWriter quads(window->DrawList, (r1 - r0) * (c1 - c0) * 2);
+        for (int r = r0; r < r1; r++) {
+            const float y = origin.y + r * step.y;
+            for (int c = c0; c < c1; c++) {
+                const int i = r * columns + c;
+                float t = (float)get_bit(i);
+                ImU32 col_bg = t > 0.0f ? col_on : col_off;
+                if (!st.Anims.empty()) {
+                    auto it = st.Anims.find(i);
+                    if (it != st.Anims.end()) {
+                        t = it->second;
+                        col_bg = disabled ? col_off : ImGui::GetColorU32(ImLerp(style.ImToggleSwitchOffColor, style.ImToggleSwitchOnColor, t));
+                    }
+                }
+                const float x = origin.x + c * step.x;
+                quads.AddRect(ImVec2(x, y), ImVec2(x + cell.x, y + cell.y), col_bg);
+                const float kx = x + pad + t * knob_travel;
+                quads.AddRect(ImVec2(kx, y + pad), ImVec2(kx + knob, y + pad + knob), col_knob);
+            }
+        }
+    }
+
+    if (hovered_cell >= 0) {
+        const int r = hovered_cell / columns, c = hovered_cell % columns;
+        const ImVec2 p(origin.x + c * step.x, origin.y + r * step.y);
+        window->DrawList->AddRect(ImVec2(p.x - 1.0f, p.y - 1.0f), ImVec2(p.x + cell.x + 1.0f, p.y + cell.y + 1.0f), ImGui::GetColorU32(ImGuiCol_Text));
+        if (!(flags & ImToggleGridFlags_NoTooltip) && st.PaintValue < 0) {
+            ImGui::BeginTooltip();
+            if (row_labels)
+                ImGui::TextUnformatted(row_labels[r]);
+            else
+                ImGui::Text("Row %d", r);
+            ImGui::SameLine();
+            ImGui::TextDisabled("/");
+            ImGui::SameLine();
+            if (column_labels)
+                ImGui::TextUnformatted(column_labels[c]);
+            else
+                ImGui::Text("Column %d", c);
+            ImGui::Text("%s", get_bit(hovered_cell) ? "On" : "Off");
+            ImGui::EndTooltip();
+        }
+    }
+    return changed;
+}
+
+/*
+    PROGRESS LIST
+*/
+
+struct ImProgressListRow {
+    const char* Label;          // Null when the label is in the text buffer
+    int         LabelBegin;     // Offsets in the text buffer
+    int         LabelEnd;
+    int         ValueBegin;
+    int         ValueEnd;
+    float       Progress;
+    int         State;
+};
+
+static void ProgressListArrayGetItem(void* user_data, int index, ImProgressItem* out) {
+    *out = ((const ImProgressItem*)user_data)[index];
+}
+
+static void ProgressListEx(const char* label, ImProgressListGetItemFn get_item, void* user_data, int items_count, ImProgressListFlags flags) {
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+    const ImWidgetsStyle& style = GetContext().Style;
+    static const char* state_names[] = { "Queued", "Running", "Done", "Failed" };
+    ImGui::PushID(label);
+
+    ImProgressItem item;
+    if (!(flags & ImProgressListFlags_NoTotals)) {
+        int counts[ImProgressItemState_COUNT] = {};
+        ImU64 current = 0, total = 0;
+        for (int i = 0; i < items_count; i++) {
+            get_item(user_data, i, &item);
+            counts[ImClamp(item.State, 0, ImProgressItemState_COUNT - 1)]++;
+            current += ImMin(item.Current, item.Total);
+            total += item.Total;
+        }
+        ImGui::Text("%d running, %d queued, %d done, %d failed - %llu / %llu (%.1f%%)",
+            counts[ImProgressItemState_Running], counts[ImProgressItemState_Queued], counts[ImProgressItemState_Done], counts[ImProgressItemState_Failed],
+            (unsigned long long)current, (unsigned long long)total, total ? (double)current * 100.0 / (double)total : 0.0);
+    }
+
+    const float row_height = style.ImProgressListRowHeight > 0.0f ? style.ImProgressListRowHeight : ImGui::GetFrameHeight();
+    const float spacing = ImGui::GetStyle().ItemInnerSpacing.x;
+    const ImVec2 origin = window->DC.CursorPos;
+    const ImVec2 size(ImMax(ImGui::GetContentRegionAvail().x, 1.0f), row_height * items_count);
+    const ImRect frame(origin, ImVec2(origin.x + size.x, origin.y + size.y));
+    const ImGuiID id = ImGui::GetID("##rows");
+    ImGui::ItemSize(size);
+    if (!ImGui::ItemAdd(frame, id)) {
+        ImGui::PopID();
+        return;
+    }
+
+    // Read and format the visible rows only
+    const int first = ImClamp((int)floorf((window->ClipRect.Min.y - origin.y) / row_height), 0, items_count);
+    const int last = ImClamp((int)ceilf((window->ClipRect.Max.y - origin.y) / row_height), first, items_count);
+    const bool labels = !(flags & ImProgressListFlags_NoLabels);
+    const int row_chars = 96;
+    ImProgressListRow* rows = FrameAllocArray<ImProgressListRow>(last - first);
+    char* text = FrameAllocArray<char>((last - first) * row_chars);
+    int text_size = 0;
+    for (int i = first; i < last; i++) {
+        get_item(user_data, i, &item);
+        char* begin = text + text_size;
+        char* p = begin;
+        ImProgressListRow row;
+        row.State = ImClamp(item.State, 0, ImProgressItemState_COUNT - 1);
+        const ImU64 current = ImMin(item.Current, item.Total);
+        row.Progress = item.Total ? (float)((double)current / (double)item.Total) : (row.State == ImProgressItemState_Done ? 1.0f : 0.0f);
+        row.Label = item.Label;
+        row.LabelBegin = row.LabelEnd = text_size;
+        if (labels && !item.Label) {
+            *p++ = '#';
+            p = ImWidgets::FormatUnsigned(p, (ImU64)i);
+            row.LabelEnd = text_size + (int)(p - begin);
+        }
+        row.ValueBegin = text_size + (int)(p - begin);
+        if (row.State == ImProgressItemState_Queued) {
+            p = FormatLiteral(p, "Queued");
+        } else {
+            p = ImWidgets::FormatUnsigned(p, item.Current);
+            p = FormatLiteral(p, " / ");
+            p = ImWidgets::FormatUnsigned(p, item.Total);
+            p = FormatLiteral(p, "  ");
+            if (row.State == ImProgressItemState_Failed) {
+                p = FormatLiteral(p, "Failed");
+            } else {
+                p = ImWidgets::FormatUnsigned(p, (ImU64)(row.Progress * 100.0f));
+                *p++ = '%';
+            }
+        }
+        row.ValueEnd = text_size + (int)(p - begin);
+        text_size += (int)(p - begin);
+        rows[i - first] = row;
+    }
+
+    // Every bar in one batch, then the text on top
+    const float bar_x = labels ? origin.x + ImMin(style.ImProgressListLabelWidth, size.x * 0.5f) : origin.x;
+    const float bar_width = frame.Max.x - bar_x;
+    const ImU32 state_colors[] = {
+        ImWidgets::GetColorU32(ImWidgetsCol_ProgressListQueued),
+        ImWidgets::GetColorU32(ImWidgetsCol_ProgressBar),
+        ImWidgets::GetColorU32(ImWidgetsCol_ProgressListDone),
+        ImWidgets::GetColorU32(ImWidgetsCol_ProgressListFailed),
+    };
+    const ImU32 col_bg = ImWidgets::GetColorU32(ImWidgetsCol_ProgressBarBg);
+    ImDrawList* draw_list = window->DrawList;
+    {
+        ImQuadWriter quads(draw_list, (last - first) * 2);
+        for (int r = 0; r < last - first; r++) {
+            const ImProgressListRow& row = rows[r];
+            const float y = origin.y + (first + r) * row_height;
+            quads.AddRect(ImVec2(bar_x, y + 1.0f), ImVec2(frame.Max.x, y + row_height - 1.0f), col_bg);
+            const float fill = row.State == ImProgressItemState_Queued ? 0.0f : row.Progress * bar_width;
+            if (fill > 0.0f)
+                quads.AddRect(ImVec2(bar_x, y + 1.0f), ImVec2(bar_x + fill, y + row_height - 1.0f), state_colors[row.State]);
+        }
+    }
+    const ImU32 col_text = ImGui::GetColorU32(ImGuiCol_Text);
+    const ImU32 col_value = ImWidgets::GetColorU32(ImWidgetsCol_ProgressBarText);
+    const float text_offset = (row_height - ImGui::GetFontSize()) * 0.5f;
+    for (int r = 0; r < last - first; r++) {
+        const ImProgressListRow& row = rows[r];
+        const float y = origin.y + (first + r) * row_height + text_offset;
+        if (labels) {
+            const char* label_begin = row.Label ? row.Label : text + row.LabelBegin;
+            const char* label_end = row.Label ? nullptr : text + row.LabelEnd;
+            DrawTextWithEllipsis(draw_list, ImVec2(origin.x, y), col_text, label_begin, label_end, bar_x - origin.x - spacing);
+        }
+        const char* value = text + row.ValueBegin;
+        const char* value_end = text + row.ValueEnd;
+        const float value_width = ImGui::CalcTextSize(value, value_end).x;
+        draw_list->AddText(ImVec2(bar_x + (bar_width - value_width) * 0.5f, y), col_value, value, value_end);
+    }
+
+    if (!(flags & ImProgressListFlags_NoTooltip) && ImGui::IsItemHovered()) {
+        const int i = (int)floorf((ImGui::GetIO().MousePos.y - origin.y) / row_height);
+        if (i >= 0 && i < items_count) {
+            get_item(user_data, i, &item);
+            const float y = origin.y + i * row_height;
+            draw_list->AddRect(ImVec2(origin.x, y), ImVec2(frame.Max.x, y + row_height), ImGui::GetColorU32(ImGuiCol_FrameBgHovered));
+            ImGui::BeginTooltip();
+            if (item.Label)
+                ImGui::TextUnformatted(item.Label);
+            else
+                ImGui::Text("#%d", i);
+            ImGui::Text("%s: %llu / %llu", state_names[ImClamp(item.State, 0, ImProgressItemState_COUNT - 1)], (unsigned long long)item.Current, (unsigned long long)item.Total);
+            ImGui::EndTooltip();
+        }
+    }
+    ImGui::PopID();
+}
+
+void ImWidgets::ProgressList(const char* label, const ImProgressItem* items, int items_count, ImProgressListFlags flags) {
+    ProgressListEx(label, ProgressListArrayGetItem, (void*)items, items_count, flags);
+}
+
+void ImWidgets::ProgressList(const char* label, ImProgressListGetItemFn get_item, void* user_data, int items_count, ImProgressListFlags flags) {
+    ProgressListEx(label, get_item, user_data, items_count, flags);
+}
+
+/*
+    PARALLEL DRAWING
+*/
+
+// Draw list of one job. The shared data is a private copy because drawing writes to its TempBuffer
+struct ImDrawFragment {
+    ImDrawListSharedData    SharedData;
+    ImDrawList              DrawList{ &SharedData };
+    int                     VtxBase = 0;    // Where the buffers go in the target draw list
+    int                     IdxBase = 0;
+
+    void Reset(const ImDrawList* target) {
+        const ImDrawListSharedData* src = target->_Data;
+        SharedData.TexUvWhitePixel = src->TexUvWhitePixel;
+        SharedData.TexUvLines = src->TexUvLines;
+        SharedData.FontAtlas = src->FontAtlas;
+        SharedData.Font = src->Font;
+        SharedData.FontSize = src->FontSize;
+        SharedData.FontScale = src->FontScale;
+        SharedData.CurveTessellationTol = src->CurveTessellationTol;
+        SharedData.CircleSegmentMaxError = src->CircleSegmentMaxError;
+        SharedData.InitialFringeScale = src->InitialFringeScale;
+        SharedData.InitialFlags = src->InitialFlags;
+        SharedData.ClipRectFullscreen = src->ClipRectFullscreen;
+        SharedData.Context = src->Context;
+        memcpy(SharedData.ArcFastVtx, src->ArcFastVtx, sizeof(src->ArcFastVtx));
+        SharedData.ArcFastRadiusCutoff = src->ArcFastRadiusCutoff;
+        memcpy(SharedData.CircleSegmentCounts, src->CircleSegmentCounts, sizeof(src->CircleSegmentCounts));
+
+        DrawList._ResetForNewFrame();
+        DrawList.Flags = target->Flags;
+        DrawList._FringeScale = target->_FringeScale;
+        DrawList.PushTexture(target->_CmdHeader.TexRef);
+        const ImVec4& clip = target->_CmdHeader.ClipRect;
+        DrawList.PushClipRect(ImVec2(clip.x, clip.y), ImVec2(clip.z, clip.w));
+    }
+
+    // With large mesh support the indices are copied as is and each command is moved by VtxOffset,
+    // otherwise they are rebased on the vertex offset dst is drawing with
+    void CopyBuffers(ImDrawList* dst) const {
+        memcpy(dst->VtxBuffer.Data + VtxBase, DrawList.VtxBuffer.Data, (size_t)DrawList.VtxBuffer.Size * sizeof(ImDrawVert));
+        if (dst->Flags & ImDrawListFlags_AllowVtxOffset) {
+            memcpy(dst->IdxBuffer.Data + IdxBase, DrawList.IdxBuffer.Data, (size_t)DrawList.IdxBuffer.Size * sizeof(ImDrawIdx));
+            return;
+        }
+        for (const ImDrawCmd& cmd : DrawList.CmdBuffer) {
+            const unsigned int rebase = VtxBase + cmd.VtxOffset - dst->_CmdHeader.VtxOffset;
+            IM_ASSERT(sizeof(ImDrawIdx) == 4 || rebase + DrawList.VtxBuffer.Size <= 0x10000);
+            const ImDrawIdx* in = DrawList.IdxBuffer.Data + cmd.IdxOffset;
+            ImDrawIdx* out = dst->IdxBuffer.Data + IdxBase + cmd.IdxOffset;
+            for (unsigned int i = 0; i < cmd.ElemCount; i++)
+                out[i] = (ImDrawIdx)(in[i] + rebase);
+        }
+    }
+
+    void AppendCommands(ImDrawList* dst) const {
+        const bool vtx_offset = (dst->Flags & ImDrawListFlags_AllowVtxOffset) != 0;
+        for (const ImDrawCmd& src_cmd : DrawList.CmdBuffer) {
+            if (src_cmd.ElemCount == 0 && src_cmd.UserCallback == nullptr)
+                continue;
+            ImDrawCmd cmd = src_cmd;
+            cmd.IdxOffset += IdxBase;
+            cmd.VtxOffset = vtx_offset ? cmd.VtxOffset + VtxBase : dst->_CmdHeader.VtxOffset;
+            dst->CmdBuffer.push_back(cmd);
+        }
+    }
+};
+
+void ImWidgets::ParallelDraw(ImDrawList* draw_list, int jobs_count, ImDrawJobFn job, void* user_data) {
+    std::vector<std::unique_ptr<ImDrawFragment>>& fragments = GetContextValue<std::vector<std::unique_ptr<ImDrawFragment>>>(ImWidgetsContextSlot_ParallelDraw);
+    while ((int)fragments.size() < jobs_count)
+        fragments.push_back(std::make_unique<ImDrawFragment>());
+    for (int i = 0; i < jobs_count; i++)
+        fragments[i]->Reset(draw_list);
+    ParallelFor(jobs_count, [&](int i) { job(user_data, i, &fragments[i]->DrawList); });
+
+    // Splice in job order: the target buffers grow once, each fragment copies into its own range in parallel,
+    // then the commands are appended and a command with the target's clip rect and texture is reopened
+    draw_list->_PopUnusedDrawCmd();
+    int vtx_size = draw_list->VtxBuffer.Size;
+    int idx_size = draw_list->IdxBuffer.Size;
+    for (int i = 0; i < jobs_count; i++) {
+        ImDrawFragment& fragment = *fragments[i];
+        fragment.DrawList._PopUnusedDrawCmd();
+        fragment.VtxBase = vtx_size;
+        fragment.IdxBase = idx_size;
+        vtx_size += fragment.DrawList.VtxBuffer.Size;
+        idx_size += fragment.DrawList.IdxBuffer.Size;
+    }
+    draw_list->VtxBuffer.resize(vtx_size);
+    draw_list->IdxBuffer.resize(idx_size);
+    ParallelFor(jobs_count, [&](int i) { fragments[i]->CopyBuffers(draw_list); });
+    for (int i = 0; i < jobs_count; i++)
+        fragments[i]->AppendCommands(draw_list);
+    draw_list->_VtxCurrentIdx = draw_list->VtxBuffer.Size - draw_list->_CmdHeader.VtxOffset;
+    draw_list->AddDrawCmd();
+}
@@ -1,12 +1,122 @@
 #include <GLFW/glfw3.h>
 #include <GL/gl.h>
 #include <iostream>
+#include <string>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <cmath>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 #include "im_widgets.h"
 #include "../imgui/imgui_internal.h"
 
+// Synthetic columns for the data grid demo, computed from the row index so any row count costs no memory
+static ImU32 demo_hash(int row) {
+    ImU32 h = (ImU32)row * 2654435761u;
+    return h ^ (h >> 16);
+}
+static double demo_latency(void*, int row) { return (demo_hash(row) % 100000) / 100.0; }
+static double demo_status(void*, int row) { return (double)(200 + (demo_hash(row) % 5) * 100); }
+static const char* demo_host(void*, int row, char* buf, int buf_size) {
+    snprintf(buf, buf_size, "host-%04u.eu-%u", demo_hash(row) % 10000, demo_hash(row + 1) % 4);
+    return buf;
+}
+
+// Synthetic hierarchy for the tree view demo, every third node has 100k children
+static void demo_load_children(void*, ImU64 node_id, ImTreeViewChildren* out) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    int count = node_id == 0 ? 10 : (node_id % 3 == 0 ? 100000 : 20);
+    char label[64];
+    for (int i = 0; i < count; i++) {
+        ImU64 child_id = node_id * 100003 + i + 1;
+        snprintf(label, sizeof(label), "Object #%llu", (unsigned long long)child_id);
+        out->Add(child_id, label, true);
+    }
+}
+
+// Synthetic telemetry for the line plot demo
+static void demo_append_telemetry(std::vector<float>& samples, int count) {
+    for (int i = 0; i < count; i++) {
+        float t = (float)samples.size();
+        samples.push_back(sinf(t * 1e-5f) + 0.3f * sinf(t * 7e-3f) + ((demo_hash((int)samples.size()) % 1000) - 500) * 2e-4f);
+    }
+}
+
+// Synthetic profile for the flame graph demo: a random walk over call depth, costs summed bottom-up
+static void demo_build_profile(std::vector<ImFlameGraphNode>& nodes, ImFlameGraphNames& names, int count) {
+    static const char* modules[] = { "net", "db", "render", "json", "alloc", "sched" };
+    char name[64];
+    for (int i = 0; i < 600; i++) {
+        snprintf(name, sizeof(name), "%s::%s_%d", modules[i % 6], i % 2 ? "handle_request" : "process_batch", i);
+        names.Intern(name);
+    }
+    nodes.resize(count);
+    std::vector<int> path(1, -1);
+    for (int i = 0; i < count; i++) {
+        ImU32 h = demo_hash(i);
+        if (h % 100 < 45 && path.size() > 1)
+            path.pop_back();
+        nodes[i] = { path.back(), (int)(h >> 8) % names.Size(), 0.0f, (float)(h % 97) };
+        if (path.size() < 64)
+            path.push_back(i);
+    }
+    for (int i = count - 1; i >= 0; i--) {
+        nodes[i].Total += nodes[i].Self;
+        if (nodes[i].Parent >= 0)
+            nodes[nodes[i].Parent].Total += nodes[i].Total;
+    }
+}
+
+// Synthetic trace for the timeline demo: 32 threads over three days from 'start', nested request/query spans
+static void demo_build_trace(std::vector<ImTimelineSpan>& spans, int count, double start) {
+    static const char* labels[] = { "handle_request", "db::query", "serialize", "cache::lookup" };
+    const double duration = 3 * 86400.0;
+    spans.resize(count);
+    for (int i = 0; i < count; i++) {
+        ImU32 h = demo_hash(i);
+        double t = start + duration * i / count;
+        double length = (h % 1000 == 0) ? 600.0 + h % 3600 : (h % 100 + 1) * 0.002;
+        spans[i] = { t, t + length, (int)(h >> 8) % 32, 0, labels[(h >> 4) % 4] };
+        if (h % 7 == 0)
+            spans[i].Color = IM_COL32(230, 120, 60, 255);
+    }
+}
+
+// Particle field for the parallel drawing demo, each job draws its own slice of the particles
+struct DemoParticles {
+    ImVec2  Origin;
+    ImVec2  Size;
+    float   Time;
+    int     PerJob;
+};
+static void demo_draw_particles(void* user_data, int job, ImDrawList* draw_list) {
+    const DemoParticles* p = (const DemoParticles*)user_data;
+    for (int i = job * p->PerJob; i < (job + 1) * p->PerJob; i++) {
+        ImU32 h = demo_hash(i);
+        float angle = (h % 6283) * 1e-3f + p->Time * (0.2f + (h >> 16) % 100 * 0.004f);
+        float radius = ((h >> 8) % 1000) * 1e-3f;
+        ImVec2 center(p->Origin.x + p->Size.x * (0.5f + 0.5f * radius * cosf(angle)), p->Origin.y + p->Size.y * (0.5f + 0.5f * radius * sinf(angle)));
+        draw_list->AddCircleFilled(center, 1.5f + (h % 3), IM_COL32(80 + h % 176, 120, 255 - h % 128, 200), 8);
+    }
+}
+
+// Synthetic command names for the fuzzy search demo, like "git.commit_staged_file.1234"
+static void demo_build_commands(std::vector<std::string>& names, std::vector<const char*>& items, int count) {
+    static const char* words[] = { "open", "close", "file", "window", "render", "texture", "buffer", "search", "replace", "project",
+                                   "build", "debug", "toggle", "panel", "terminal", "git", "commit", "staged", "format", "document" };
+    names.resize(count);
+    items.resize(count);
+    for (int i = 0; i < count; i++) {
+        ImU32 h = demo_hash(i);
+        names[i] = std::string(words[h % 20]) + "." + words[(h >> 5) % 20] + "_" + words[(h >> 10) % 20] + "_" + words[(h >> 15) % 20] + "." + std::to_string(i);
+        items[i] = names[i].c_str();
+    }
+}
+
 void error_callback(int error, const char* description) {
     std::cerr << "GLFW Error: " << description << std::endl;
 }
@@ -42,11 +152,20 @@ int main() {
     const char* options[] = { "Low", "Medium", "High" };
     static float progress = 0.0f;
     static int day = 0, month = 0, year = 0;
+    static std::string release_notes;
+    for (int i = 1; i <= 500; i++) {
+        release_notes += "[size=1.3][b]Release 1." + std::to_string(i) + "[/b][/size]\n";
+        release_notes += "[color=80C0FFFF]Fixed[/color] a [i]very[/i] long standing issue where the widget would wrap text incorrectly "
+                         "when mixing [b]bold[/b] and regular runs. See [url=https://github.com/ocornut/imgui]Dear ImGui[/url] for details.\n\n";
+    }
 
     // Customize styles
     ImWidgetsStyle& style = ImWidgets::GetStyle();
     style.ImProgressBarSize = ImVec2(250, 24);
 
+    // Second ImGui context of the "Contexts" tab, built offscreen: ImWidgets gives it its own style and widget states
+    ImGuiContext* surface_context = nullptr;
+
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
 
@@ -65,37 +184,560 @@ int main() {
         ImGui::Separator();
         ImGui::Dummy(ImVec2(0, 15));
 
-        // Toggle Switch
-        ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Toggle Switch");
-        ImWidgets::ToggleSwitch("Enable Feature", &enabled);
-        ImGui::Text("Feature is %s", enabled ? "Enabled" : "Disabled");
-        ImGui::Dummy(ImVec2(0, 20));
-
-        // Radio Button Group
-        ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Radio Button Group");
-        ImWidgets::RadioButtonGroup("Quality", &selected, options, 3);
-        ImGui::Text("Selected: %s", options[selected]);
-        ImGui::Dummy(ImVec2(0, 20));
-
-        // Progress Bars
-        ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Progress Bar");
-        ImWidgets::ProgressBar("Loading", 0, 100, progress, ImProgressBarFlags_PercentageLabel);
+        if (ImGui::BeginTabBar("Gallery")) {
+            if (ImGui::BeginTabItem("Basics")) {
+                // Toggle Switch
+                ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Toggle Switch");
+                ImWidgets::ToggleSwitch("Enable Feature", &enabled);
+                ImGui::Text("Feature is %s", enabled ? "Enabled" : "Disabled");
+                ImGui::Dummy(ImVec2(0, 20));
+
+                // Radio Button Group
+                ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Radio Button Group");
+                ImWidgets::RadioButtonGroup("Quality", &selected, options, 3);
+                ImGui::Text("Selected: %s", options[selected]);
+                static char channel_names[500][16];
+                static const char* channels[500];
+                static int channel = 0;
+                if (!channels[0]) {
+                    for (int i = 0; i < 500; i++) {
+                        snprintf(channel_names[i], sizeof(channel_names[i]), "Channel %d", i + 1);
+                        channels[i] = channel_names[i];
+                    }
+                }
+                ImGui::BeginChild("##channels", ImVec2(0, ImWidgets::GetStyle().ImRadioButtonGroupSize.y + ImGui::GetStyle().ScrollbarSize + 8.0f), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
+                ImWidgets::RadioButtonGroup("Channel", &channel, channels, 500, ImRadioButtonGroupFlags_Virtualized);
+                ImGui::EndChild();
+                ImGui::Text("Channel: %s", channels[channel]);
+                ImGui::Dummy(ImVec2(0, 20));
+
+                // Progress Bars
+                ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Progress Bar");
+                ImWidgets::ProgressBar("Loading", 0, 100, progress, ImProgressBarFlags_PercentageLabel);
+                ImGui::Dummy(ImVec2(0, 5));
+                ImWidgets::ProgressBar("Download", 0, 100, progress, "%.1f / %.0f MB (%.0f%%)");
         
-        ImGui::Dummy(ImVec2(0, 10));
-        ImGui::Dummy(ImVec2(20, 0));
-        ImGui::SameLine();
-        ImWidgets::ProgressBar("Circular", 0, 100, progress, ImProgressBarFlags_Circle | ImProgressBarFlags_PercentageLabel);
-        ImGui::Dummy(ImVec2(0, 20));
-
-        // Spinner
-        ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Spinner");
-        ImWidgets::Spinner("Processing...", ImSpinnerFlags_LabelRight);
-        ImGui::Dummy(ImVec2(0, 20));
-
-        // Calendar
-        ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Calendar");
-        ImWidgets::Calendar("Date Picker", day, month, year);
-        ImGui::Text("Selected Date: %02d/%02d/%04d", day, month, year);
+                ImGui::Dummy(ImVec2(0, 10));
+                ImGui::Dummy(ImVec2(20, 0));
+                ImGui::SameLine();
+                ImWidgets::ProgressBar("Circular", 0, 100, progress, ImProgressBarFlags_Circle | ImProgressBarFlags_PercentageLabel);
+                ImGui::Dummy(ImVec2(0, 20));
+
+                // Spinner
+                ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Spinner");
+                ImWidgets::Spinner("Processing...", ImSpinnerFlags_LabelRight);
+                ImGui::Dummy(ImVec2(0, 20));
+
+                // Calendar
+                ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Calendar");
+                ImWidgets::Calendar("Date Picker", day, month, year);
+                ImGui::Text("Selected Date: %02d/%02d/%04d", day, month, year);
+                ImGui::EndTabItem();
+            }
+
+            if (ImGui::BeginTabItem("Rich Text")) {
+                static const char* clicked_link = "";
+                const char* link = nullptr;
+                ImGui::Text("Last clicked link: %s", clicked_link);
+                ImGui::BeginChild("ReleaseNotes", ImVec2(0, 0), ImGuiChildFlags_Borders);
+                if (ImWidgets::RichText("Release Notes", release_notes.c_str(), release_notes.c_str() + release_notes.size(), &link))
+                    clicked_link = link;
+                ImGui::EndChild();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Log Viewer")) {
+                static char log_path[512] = "imwidgets_demo.log";
+                static int appended = 0;
+                ImGui::InputText("File", log_path, sizeof(log_path));
+                ImGui::SameLine();
+                if (ImGui::Button("Append 10k lines")) {
+                    if (FILE* f = fopen(log_path, "ab")) {
+                        const char* levels[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+                        for (int i = 0; i < 10000; i++, appended++)
+                            fprintf(f, "2025-01-01 12:00:00 %-5s worker-%d request %d completed\n", levels[appended % 4], appended % 8, appended);
+                        fclose(f);
+                    }
+                }
+                ImWidgets::LogViewer("Service Log", log_path, ImLogViewerFlags_LineNumbers | ImLogViewerFlags_Search);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Data Grid")) {
+                static int rows_count = 1000;
+                static const ImDataGridColumn columns[] = {
+                    { "Host",       ImGuiDataType_COUNT, nullptr, 0, nullptr,        demo_host, nullptr, nullptr },
+                    { "Status",     ImGuiDataType_COUNT, nullptr, 0, demo_status,    nullptr,   nullptr, "%.0f" },
+                    { "Latency ms", ImGuiDataType_COUNT, nullptr, 0, demo_latency,   nullptr,   nullptr, "%.2f" },
+                };
+                ImGui::SetNextItemWidth(300);
+                ImGui::SliderInt("Rows", &rows_count, 1000, 10000000, "%d", ImGuiSliderFlags_Logarithmic);
+                ImGui::SameLine();
+                ImGui::Text("%.2f ms/frame", 1000.0f / io.Framerate);
+                ImWidgets::DataGrid("Hosts", columns, IM_ARRAYSIZE(columns), rows_count);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Tree View")) {
+                static ImU64 selected_object = 0;
+                ImGui::Text("Selected: #%llu", (unsigned long long)selected_object);
+                ImWidgets::TreeView("Objects", demo_load_children, nullptr, &selected_object);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Line Plot")) {
+                static std::vector<float> telemetry;
+                static bool streaming = true;
+                if (telemetry.empty()) {
+                    telemetry.reserve(10000000);
+                    demo_append_telemetry(telemetry, 1000000);
+                }
+                if (streaming && telemetry.size() < 10000000)
+                    demo_append_telemetry(telemetry, 20000);
+                ImGui::Checkbox("Stream", &streaming);
+                ImGui::SameLine();
+                ImGui::Text("%d samples, %.2f ms/frame", (int)telemetry.size(), 1000.0f / io.Framerate);
+                ImWidgets::GetStyle().ImLinePlotSize = ImVec2(0, 300);
+                ImWidgets::LinePlot("Telemetry", telemetry.data(), (int)telemetry.size());
+
+                // 100 kHz acquisition thread feeding a ring buffer, never freed since the thread runs until exit
+                static ImTimeSeries* sensor = nullptr;
+                if (!sensor) {
+                    sensor = new ImTimeSeries(1 << 22);
+                    std::thread([]() {
+                        float block[1000];
+                        for (ImU64 t = 0;; ) {
+                            for (float& v : block) {
+                                v = sinf(t * 2e-4f) * (1.0f + 0.2f * sinf(t * 1e-6f)) + ((demo_hash((int)t) % 1000) - 500) * 4e-4f;
+                                t++;
+                            }
+                            sensor->Push(block, IM_ARRAYSIZE(block));
+                            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                        }
+                    }).detach();
+                }
+                ImGui::Text("Sensor: %llu samples pushed, last %d kept", (unsigned long long)sensor->Size(), sensor->Count());
+                ImWidgets::LinePlot("Sensor", *sensor);
+
+                // 250M samples generated in the background, the pyramid is extended as they arrive
+                static float* archive = nullptr;
+                static std::atomic<ImU64> archive_count{ 0 };
+                const ImU64 archive_size = 250000000;
+                if (!archive && ImGui::Button("Generate 250M samples (1 GB)")) {
+                    archive = new float[archive_size];
+                    std::thread([archive_size]() {
+                        for (ImU64 t = 0; t < archive_size; t += 1000000) {
+                            for (ImU64 i = t; i < t + 1000000; i++)
+                                archive[i] = sinf(i * 1e-7f) + 0.25f * sinf(i * 3e-4f) + ((demo_hash((int)i) % 1000) - 500) * 1e-4f;
+                            archive_count = t + 1000000;
+                        }
+                    }).detach();
+                }
+                if (archive)
+                    ImWidgets::LinePlotLod("Archive", archive, archive_count.load());
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Histogram")) {
+                static std::vector<float> latencies;
+                static int bins_count = 100;
+                static bool streaming = true;
+                if (latencies.empty())
+                    latencies.reserve(20000000);
+                if (streaming && latencies.size() < 20000000) {
+                    // Log-normal-ish latencies from the demo hash
+                    for (int i = 0; i < 50000; i++) {
+                        ImU32 h = demo_hash((int)latencies.size());
+                        latencies.push_back(expf(((h & 0xFFFF) + ((h >> 16) & 0xFFFF)) / 65536.0f * 1.5f));
+                    }
+                }
+                ImGui::Checkbox("Stream", &streaming);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(200);
+                ImGui::SliderInt("Bins", &bins_count, 10, 2000, "%d", ImGuiSliderFlags_Logarithmic);
+                ImGui::SameLine();
+                ImGui::Text("%d samples, %.2f ms/frame", (int)latencies.size(), 1000.0f / io.Framerate);
+                ImWidgets::Histogram("Latency", latencies.data(), (int)latencies.size(), bins_count);
+                ImWidgets::Histogram("Latency 1-5", latencies.data(), (int)latencies.size(), bins_count, 1.0f, 5.0f);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Heatmap")) {
+                // 2048x2048 latency matrix, a few thousand cells change per frame and only those are uploaded
+                const int grid_size = 2048;
+                static std::vector<float> matrix;
+                static int frame_index = 0;
+                if (matrix.empty()) {
+                    matrix.resize(grid_size * grid_size);
+                    for (int i = 0; i < grid_size * grid_size; i++)
+                        matrix[i] = (float)(demo_hash(i) % 1000);
+                }
+                for (int i = 0; i < 4096; i++) {
+                    ImU32 h = demo_hash(frame_index * 4096 + i);
+                    int x = h % grid_size, y = (h >> 11) % grid_size;
+                    matrix[y * grid_size + x] = (float)(demo_hash((int)h) % 1000);
+                    ImWidgets::HeatmapInvalidate("Latency Matrix", x, y, 1, 1);
+                }
+                frame_index++;
+                ImGui::Text("%.2f ms/frame", 1000.0f / io.Framerate);
+                ImWidgets::GetStyle().ImHeatmapSize = ImVec2(512, 512);
+                ImWidgets::Heatmap("Latency Matrix", matrix.data(), grid_size, grid_size, 0.0f, 1000.0f);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Sparklines")) {
+                // 5000 services with 120 samples each, a few services get a new sample every frame
+                const int services_count = 5000, history = 120;
+                static std::vector<float> requests;
+                static std::vector<int> versions;
+                static int tick = 0;
+                if (requests.empty()) {
+                    requests.resize(services_count * history);
+                    versions.resize(services_count);
+                    for (int i = 0; i < services_count * history; i++)
+                        requests[i] = (float)(demo_hash(i) % 100);
+                }
+                for (int i = 0; i < 50; i++, tick++) {
+                    int service = demo_hash(tick) % services_count;
+                    float* row = &requests[service * history];
+                    memmove(row, row + 1, (history - 1) * sizeof(float));
+                    row[history - 1] = (float)(demo_hash(tick + 1) % 100);
+                    versions[service]++;
+                }
+                ImGui::Text("%.2f ms/frame", 1000.0f / io.Framerate);
+                ImWidgets::BeginSparklines();
+                if (ImGui::BeginTable("Services", 2, ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+                    ImGui::TableSetupScrollFreeze(0, 1);
+                    ImGui::TableSetupColumn("Service", ImGuiTableColumnFlags_WidthFixed, 150.0f);
+                    ImGui::TableSetupColumn("Requests/s");
+                    ImGui::TableHeadersRow();
+                    ImGuiListClipper clipper;
+                    clipper.Begin(services_count);
+                    while (clipper.Step()) {
+                        for (int service = clipper.DisplayStart; service < clipper.DisplayEnd; service++) {
+                            ImGui::TableNextRow();
+                            ImGui::TableNextColumn();
+                            ImGui::Text("service-%04d", service);
+                            ImGui::TableNextColumn();
+                            ImGui::PushID(service);
+                            ImGui::SetNextItemWidth(-FLT_MIN);
+                            ImWidgets::Sparkline("##requests", &requests[service * history], history, versions[service]);
+                            ImGui::PopID();
+                        }
+                    }
+                    ImGui::EndTable();
+                }
+                ImWidgets::EndSparklines();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Scatter Plot")) {
+                // 10M points in three clusters, binned into a density texture on worker threads
+                const int points_count = 10000000;
+                static std::vector<float> xs, ys;
+                static bool binned_markers = false;
+                if (xs.empty()) {
+                    xs.resize(points_count);
+                    ys.resize(points_count);
+                    for (int i = 0; i < points_count; i++) {
+                        // Sum of uniforms approximates a normal distribution
+                        float gx = 0.0f, gy = 0.0f;
+                        for (int k = 0; k < 4; k++) {
+                            gx += (demo_hash(i * 8 + k) % 10000) / 10000.0f - 0.5f;
+                            gy += (demo_hash(i * 8 + 4 + k) % 10000) / 10000.0f - 0.5f;
+                        }
+                        int cluster = i % 3;
+                        xs[i] = gx * (1.0f + cluster) + cluster * 3.0f;
+                        ys[i] = gy * (2.0f - cluster * 0.5f) + gx * cluster;
+                    }
+                }
+                ImGui::Checkbox("Binned markers", &binned_markers);
+                ImGui::SameLine();
+                ImGui::Text("%d points, %.2f ms/frame", points_count, 1000.0f / io.Framerate);
+                ImWidgets::ScatterPlot("Clusters", xs.data(), ys.data(), points_count, 0, binned_markers ? ImScatterPlotFlags_BinnedMarkers : ImScatterPlotFlags_None);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Flame Graph")) {
+                // 5M-frame synthetic profile, laid out lazily for the visible range
+                static std::vector<ImFlameGraphNode> profile;
+                static ImFlameGraphNames profile_names;
+                static bool inverted = false;
+                if (profile.empty())
+                    demo_build_profile(profile, profile_names, 5000000);
+                ImGui::Checkbox("Inverted", &inverted);
+                ImGui::SameLine();
+                ImGui::Text("%d nodes, %.2f ms/frame", (int)profile.size(), 1000.0f / io.Framerate);
+                ImWidgets::FlameGraph("Profile", profile.data(), (int)profile.size(), profile_names, 0, inverted ? ImFlameGraphFlags_Inverted : ImFlameGraphFlags_None);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Timeline")) {
+                // 5M spans over three days, the calendar jumps to a day
+                static std::vector<ImTimelineSpan> trace;
+                static int trace_day = 17, trace_month = 10, trace_year = 2026;
+                if (trace.empty())
+                    demo_build_trace(trace, 5000000, ImWidgets::DateToTime(trace_day, trace_month, trace_year));
+                ImGui::BeginGroup();
+                int picked_day = trace_day;
+                ImWidgets::Calendar("Trace Day", trace_day, trace_month, trace_year);
+                if (picked_day != trace_day) {
+                    double day_start = ImWidgets::DateToTime(trace_day, trace_month, trace_year);
+                    ImWidgets::TimelineSetView("Trace", day_start, day_start + 86400.0);
+                }
+                ImGui::EndGroup();
+                ImGui::SameLine();
+                ImGui::BeginGroup();
+                ImGui::Text("%d spans, %.2f ms/frame", (int)trace.size(), 1000.0f / io.Framerate);
+                ImWidgets::Timeline("Trace", trace.data(), (int)trace.size(), 0, ImTimelineFlags_DateAxis);
+                ImGui::EndGroup();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Hex Viewer")) {
+                static char hex_path[512] = "imwidgets_demo.bin";
+                ImGui::InputText("File", hex_path, sizeof(hex_path));
+                ImGui::SameLine();
+                if (ImGui::Button("Write 256 MB sample")) {
+                    // Mostly zeros with a record every 4 KB, search for CA FE or "record"
+                    if (FILE* f = fopen(hex_path, "wb")) {
+                        std::vector<unsigned char> page(4096);
+                        for (int i = 0; i < 65536; i++) {
+                            memset(page.data(), 0, page.size());
+                            page[0] = 0xCA; page[1] = 0xFE;
+                            memcpy(&page[4], &i, sizeof(i));
+                            snprintf((char*)&page[16], 32, "record %d", i);
+                            fwrite(page.data(), 1, page.size(), f);
+                        }
+                        fclose(f);
+                    }
+                }
+                ImU64 sel_offset = 0, sel_size = 0;
+                if (ImWidgets::HexViewerGetSelection("Dump", &sel_offset, &sel_size))
+                    ImGui::Text("Selection: 0x%llX, %llu bytes", (unsigned long long)sel_offset, (unsigned long long)sel_size);
+                else
+                    ImGui::TextDisabled("Click or drag to select, Ctrl+C copies");
+                ImWidgets::HexViewer("Dump", hex_path, ImHexViewerFlags_Search);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Command Palette")) {
+                // 200k commands, scored on worker threads while typing
+                static std::vector<std::string> command_names;
+                static std::vector<const char*> commands;
+                static int combo_current = 0, last_command = -1;
+                static bool palette_open = false;
+                if (commands.empty())
+                    demo_build_commands(command_names, commands, 200000);
+                ImGui::SetNextItemWidth(ImGui::GetFontSize() * 24.0f);
+                ImWidgets::FuzzyCombo("Command", &combo_current, commands.data(), (int)commands.size());
+                if (ImGui::Button("Open palette (Ctrl+P)") || ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_P))
+                    palette_open = true;
+                ImWidgets::CommandPalette("Palette", &palette_open, &last_command, commands.data(), (int)commands.size());
+                ImGui::Text("Last command: %s", last_command >= 0 ? commands[last_command] : "none");
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Toggle Grid")) {
+                // 100 feature flags x 1000 hosts in a packed bitset
+                static std::vector<ImU32> flag_bits((100 * 1000 + 31) / 32);
+                static char host_names[1000][16], flag_names[100][16];
+                static const char* hosts[1000];
+                static const char* feature_flags[100];
+                if (!hosts[0]) {
+                    for (int i = 0; i < 1000; i++) {
+                        snprintf(host_names[i], sizeof(host_names[i]), "host-%04d", i);
+                        hosts[i] = host_names[i];
+                    }
+                    for (int i = 0; i < 100; i++) {
+                        snprintf(flag_names[i], sizeof(flag_names[i]), "feature_%02d", i);
+                        feature_flags[i] = flag_names[i];
+                    }
+                    for (size_t i = 0; i < flag_bits.size(); i++)
+                        flag_bits[i] = demo_hash((int)i);
+                }
+                int enabled_count = 0;
+                for (ImU32 word : flag_bits)
+                    enabled_count += ImCountSetBits(word);
+                ImGui::Text("%d of %d flags enabled, %.2f ms/frame", enabled_count, 100 * 1000, 1000.0f / io.Framerate);
+                ImGui::BeginChild("##grid", ImVec2(0, 0), ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+                ImWidgets::ToggleGrid("Flags", flag_bits.data(), 100, 1000, hosts, feature_flags);
+                ImGui::EndChild();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Progress List")) {
+                // 5000 transfers, 64 running at a time, advanced every frame
+                static std::vector<ImProgressItem> jobs;
+                static std::vector<std::string> job_names;
+                static int frame_counter = 0;
+                if (jobs.empty()) {
+                    jobs.resize(5000);
+                    job_names.resize(jobs.size());
+                    for (int i = 0; i < (int)jobs.size(); i++) {
+                        job_names[i] = "backup/shard-" + std::to_string(i) + ".tar";
+                        jobs[i].Current = 0;
+                        jobs[i].Total = 1000000 + (demo_hash(i) % 50000000);
+                        jobs[i].State = ImProgressItemState_Queued;
+                        jobs[i].Label = job_names[i].c_str();
+                    }
+                }
+                frame_counter++;
+                int running = 0;
+                for (int i = 0; i < (int)jobs.size(); i++) {
+                    ImProgressItem& job = jobs[i];
+                    if (job.State == ImProgressItemState_Queued && running < 64)
+                        job.State = ImProgressItemState_Running;
+                    if (job.State != ImProgressItemState_Running)
+                        continue;
+                    running++;
+                    job.Current = ImMin(job.Total, job.Current + 20000 + demo_hash(i + frame_counter) % 400000);
+                    if (demo_hash(i * 7 + frame_counter) % 20000 == 0)
+                        job.State = ImProgressItemState_Failed;
+                    else if (job.Current == job.Total)
+                        job.State = ImProgressItemState_Done;
+                }
+                if (ImGui::Button("Restart")) {
+                    for (ImProgressItem& job : jobs) {
+                        job.Current = 0;
+                        job.State = ImProgressItemState_Queued;
+                    }
+                }
+                ImGui::SameLine();
+                ImGui::Text("%.2f ms/frame", 1000.0f / io.Framerate);
+                ImGui::BeginChild("##jobs", ImVec2(0, 0), ImGuiChildFlags_Borders);
+                ImWidgets::ProgressList("Transfers", jobs.data(), (int)jobs.size());
+                ImGui::EndChild();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Parallel Drawing")) {
+                // 16 jobs building geometry on worker threads, spliced into the window draw list in job order
+                static bool parallel = true;
+                static int particles = 400000;
+                static int workers = -1;
+                ImGui::Checkbox("Parallel", &parallel);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(150);
+                ImGui::SliderInt("Particles", &particles, 16000, 1600000);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(150);
+                if (ImGui::SliderInt("Workers", &workers, -1, 32, workers < 0 ? "auto" : "%d"))
+                    ImWidgets::SetWorkerThreadCount(workers);
+                ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+                canvas_size.y -= ImGui::GetTextLineHeightWithSpacing();
+                DemoParticles scene = { ImGui::GetCursorScreenPos(), canvas_size, (float)ImGui::GetTime(), particles / 16 };
+                ImDrawList* draw_list = ImGui::GetWindowDrawList();
+                auto start = std::chrono::high_resolution_clock::now();
+                if (parallel) {
+                    ImWidgets::ParallelDraw(draw_list, 16, demo_draw_particles, &scene);
+                } else {
+                    for (int job = 0; job < 16; job++)
+                        demo_draw_particles(&scene, job, draw_list);
+                }
+                double build_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+                ImGui::Dummy(canvas_size);
+                ImGui::Text("%d particles, geometry built in %.2f ms, %.2f ms/frame", scene.PerJob * 16, build_ms, 1000.0f / io.Framerate);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Task Pool")) {
+                // Queues shared by every background job, sort a grid or zoom a plot in another tab and come back
+                ImGui::TextWrapped("Jobs of tabs that are not shown move to the background queue and are dropped after 60 frames.");
+                ImTaskQueueStats stats[ImTaskPriority_COUNT];
+                ImWidgets::GetTaskQueueStats(stats);
+                const char* queue_names[ImTaskPriority_COUNT] = { "Visible", "Background" };
+                if (ImGui::BeginTable("##queues", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                    for (const char* column : { "Queue", "Submitted", "Completed", "Dropped", "Stolen", "Pending", "Avg wait", "Max wait", "Avg run" })
+                        ImGui::TableSetupColumn(column);
+                    ImGui::TableHeadersRow();
+                    for (int p = 0; p < ImTaskPriority_COUNT; p++) {
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn(); ImGui::TextUnformatted(queue_names[p]);
+                        ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)stats[p].Submitted);
+                        ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)stats[p].Completed);
+                        ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)stats[p].Dropped);
+                        ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)stats[p].Stolen);
+                        ImGui::TableNextColumn(); ImGui::Text("%d", stats[p].Pending);
+                        ImGui::TableNextColumn(); ImGui::Text("%.2f ms", stats[p].AvgWaitMs);
+                        ImGui::TableNextColumn(); ImGui::Text("%.2f ms", stats[p].MaxWaitMs);
+                        ImGui::TableNextColumn(); ImGui::Text("%.2f ms", stats[p].AvgRunMs);
+                    }
+                    ImGui::EndTable();
+                }
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Frame Arena")) {
+                // Labels formatted into the frame arena: no heap allocation, released two frames later
+                static int labels = 10000;
+                ImGui::SetNextItemWidth(200);
+                ImGui::SliderInt("Labels", &labels, 100, 100000);
+                ImFrameArenaStats stats;
+                ImWidgets::GetFrameArenaStats(&stats);
+                ImGui::Text("Last frame %zu bytes, high water %zu bytes, %zu bytes in %d blocks",
+                    stats.LastFrameUsed, stats.HighWater, stats.Capacity, stats.Blocks);
+                if (ImGui::BeginChild("##labels", ImVec2(0, 0), ImGuiChildFlags_Borders)) {
+                    ImGuiListClipper clipper;
+                    clipper.Begin(labels);
+                    while (clipper.Step())
+                        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                            ImGui::TextUnformatted(ImWidgets::FrameFormat("Label %d of %d, %.3f s", i, labels, ImGui::GetTime()));
+                }
+                ImGui::EndChild();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Contexts")) {
+                // What a second rendering surface would do on its own thread, here on the UI thread between two of
+                // our widgets: switch context, build a frame, switch back
+                ImGuiContext* main_context = ImGui::GetCurrentContext();
+                if (!surface_context) {
+                    surface_context = ImGui::CreateContext();
+                    ImGui::SetCurrentContext(surface_context);
+                    ImGui::GetIO().IniFilename = nullptr;
+                    ImGui::GetIO().Fonts->Build();      // Nothing renders this context, no backend builds its atlas
+                    ImWidgets::GetStyle().ImToggleSwitchOnColor = ImVec4(0.85f, 0.35f, 0.25f, 1.0f);
+                    ImGui::SetCurrentContext(main_context);
+                }
+                static bool main_toggle = false;
+                static bool surface_toggle = false;
+                static int surface_frames = 0;
+                ImWidgets::ToggleSwitch("Main context", &main_toggle);
+
+                ImGui::SetCurrentContext(surface_context);
+                ImGui::GetIO().DisplaySize = ImVec2(640, 480);
+                ImGui::GetIO().DeltaTime = io.DeltaTime;
+                ImGui::NewFrame();
+                ImGui::Begin("Surface");
+                if (++surface_frames % 60 == 0)
+                    surface_toggle = !surface_toggle;
+                ImWidgets::ToggleSwitch("Surface context", &surface_toggle);
+                ImWidgets::ProgressBar("Frames", 0, 600, (float)(surface_frames % 600));
+                ImGui::End();
+                ImGui::Render();
+                const int surface_vertices = ImGui::GetDrawData()->TotalVtxCount;
+                ImGui::SetCurrentContext(main_context);
+
+                ImGui::Text("Offscreen context: frame %d, switch %s, %d vertices", surface_frames, surface_toggle ? "on" : "off", surface_vertices);
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Style Stack")) {
+                // One status color pushed per switch: the pushed colors are compiled once, popping restores them as is
+                static bool services[2000];
+                static bool services_init = false;
+                if (!services_init) {
+                    for (int i = 0; i < IM_ARRAYSIZE(services); i++)
+                        services[i] = i % 7 != 0;
+                    services_init = true;
+                }
+                const ImU32 status_colors[3] = { IM_COL32(220, 60, 50, 255), IM_COL32(230, 180, 40, 255), IM_COL32(60, 190, 90, 255) };
+
+                ImWidgets::PushStyleVar(ImWidgetsStyleVar_ToggleSwitchSize, ImVec2(56, 28));
+                ImWidgets::PushStyleVar(ImWidgetsStyleVar_ToggleSwitchRadius, 14.0f);
+                static bool large_toggle = true;
+                ImWidgets::ToggleSwitch("Pushed size", &large_toggle);
+                ImWidgets::PopStyleVar(2);
+
+                if (ImGui::BeginChild("##services", ImVec2(0, 0), ImGuiChildFlags_Borders)) {
+                    const int columns = ImMax(1, (int)(ImGui::GetContentRegionAvail().x / 60.0f));
+                    for (int i = 0; i < IM_ARRAYSIZE(services); i++) {
+                        ImGui::PushID(i);
+                        ImWidgets::PushStyleColor(ImWidgetsCol_ToggleSwitchOn, status_colors[i % 3]);
+                        ImWidgets::ToggleSwitch("##service", &services[i], ImToggleFlags_NoLabel);
+                        ImWidgets::PopStyleColor();
+                        ImGui::PopID();
+                        if ((i + 1) % columns != 0)
+                            ImGui::SameLine();
+                    }
+                }
+                ImGui::EndChild();
+                ImGui::EndTabItem();
+            }
+            ImGui::EndTabBar();
+        }
 
         ImGui::End();
 
@@ -106,6 +748,8 @@ int main() {
         glfwSwapBuffers(window);
     }
 
+    if (surface_context)
+        ImGui::DestroyContext(surface_context);
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();